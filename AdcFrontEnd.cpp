@@ -0,0 +1,42 @@
+#include "AdcFrontEnd.h"
+#include <algorithm>
+#include <cmath>
+
+static inline uint8_t clamp_u8(int v) {
+  return (uint8_t)std::min(255, std::max(0, v));
+}
+
+AdcSample AdcFrontEnd::step(double vin) {
+  // Quantize to 8-bit
+  const int     q = (int)std::lround(vin);
+  const uint8_t x = clamp_u8(q);
+
+  // Apply 1D LUT (fused: wrapper LUT and post-ISP LUT in one lookup)
+  AdcSample s;
+  if (fused_) {
+    s.pix = fused_lut_[x];
+    if (stats_.enabled()) stats_.count(pre_[x], s.pix);
+    if (lut_count_) ++*lut_count_;
+  } else {
+    s.pix = lut_.apply(x);
+  }
+
+  // HSYNC at the start of each row, VSYNC at the LAST pixel of the frame
+  s.hsync = col_ == 0;
+  s.vsync = (idx_ == (N_ - 1));
+
+  if (s.vsync && fused_) stats_.end_frame();
+
+  // Advance pixel index and column (wrap to next row / frame)
+  idx_ = s.vsync ? 0 : (idx_ + 1);
+  col_ = (s.vsync || col_ == W_ - 1) ? 0 : (col_ + 1);
+  return s;
+}
+
+void AdcFrontEnd::fuse_post_lut(const Lut1DTable& post) {
+  for (int i = 0; i < 256; ++i) {
+    pre_[i]       = lut_.apply((uint8_t)i);
+    fused_lut_[i] = post[pre_[i]];
+  }
+  fused_ = true;
+}
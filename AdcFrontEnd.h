@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include "IdentityLUT.h"
+#include "Lut1DTable.h"
+
+// Per-sample ADC front end shared by CannyEdgeWrapper (AMS) and
+// DigitalSensor_DE: quantize to 8 bits, apply the 1D LUT (or the fused
+// wrapper+post-ISP table) and generate the frame syncs.
+struct AdcSample {
+  uint8_t pix;
+  bool    hsync;   // first pixel of a row
+  bool    vsync;   // last pixel of the frame
+};
+
+class AdcFrontEnd {
+public:
+  AdcFrontEnd(int W, int H) : W_(W), N_(W*H) {}
+
+  AdcSample step(double vin);          // one sample; wraps to the next frame
+
+  IdentityLUT&       lut()       { return lut_; }
+  const IdentityLUT& lut() const { return lut_; }
+
+  // Fused ISP-bypass path: compose the post-ISP table onto this LUT so one
+  // lookup replaces wrapper LUT -> Lut1D_DE. Histograms keep Lut1D_DE
+  // semantics (in = wrapper LUT output, out = final value).
+  void fuse_post_lut(const Lut1DTable& post);
+  LutHistStats& fused_stats() { return stats_; }
+  void set_lut_counter(uint64_t* n) { lut_count_ = n; }   // energy: fused lookups
+
+private:
+  const int W_;
+  const int N_;            // total pixels per frame
+  int       idx_ = 0;      // 0 .. N_-1 (position inside frame)
+  int       col_ = 0;      // 0 .. W_-1 (hsync without a per-sample modulo)
+
+  IdentityLUT  lut_;
+  bool         fused_ = false;
+  uint8_t      pre_[256];     // wrapper LUT (histogram input)
+  uint8_t      fused_lut_[256];
+  LutHistStats stats_;
+  uint64_t*    lut_count_ = nullptr;
+};
@@ -0,0 +1,132 @@
+#pragma once
+#include <systemc>
+#include <deque>
+#include <string>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+
+// Dual-clock FIFO for clock-domain crossings (pixel stream or 256-bit buses).
+// - depth       : number of entries
+// - sync_stages : pointer synchronizer latency in destination-clock cycles.
+//                 A written entry becomes visible to the reader after
+//                 sync_stages rclk edges; a freed slot becomes visible to the
+//                 writer after sync_stages wclk edges (gray-pointer 2FF model).
+// Sources that honor ready (BurstPacker, LPDDR read) treat a beat as taken
+// when ready was high on the edge they presented it, so the FIFO accepts a
+// beat only if the ready it drove two edges earlier was high and keeps a
+// two-slot skid margin. Sources without backpressure (the ADC/LUT pixel
+// stream) are accepted while space remains and counted as overflow otherwise.
+// 'last' is carried as a sideband bit (vsync for pixel streams, wlast for the
+// write bus).
+template <class T>
+struct AsyncFifo : sc_core::sc_module {
+  // Write side (source clock domain)
+  sc_core::sc_in<bool>  wclk;
+  sc_core::sc_in<T>     data_in;
+  sc_core::sc_in<bool>  valid_in;
+  sc_core::sc_in<bool>  last_in;
+  sc_core::sc_out<bool> ready_out;
+
+  // Read side (destination clock domain)
+  sc_core::sc_in<bool>  rclk;
+  sc_core::sc_out<T>    data_out;
+  sc_core::sc_out<bool> valid_out;
+  sc_core::sc_out<bool> last_out;
+  sc_core::sc_in<bool>  ready_in;
+
+  SC_HAS_PROCESS(AsyncFifo);
+  AsyncFifo(sc_core::sc_module_name name, unsigned depth = 16, unsigned sync_stages = 2)
+  : sc_module(name),
+    wclk("wclk"), data_in("data_in"), valid_in("valid_in"), last_in("last_in"), ready_out("ready_out"),
+    rclk("rclk"), data_out("data_out"), valid_out("valid_out"), last_out("last_out"), ready_in("ready_in"),
+    depth_(std::max(2u, depth)), sync_(sync_stages)
+  {
+    SC_METHOD(write_side);
+    sensitive << wclk.pos();
+    dont_initialize();
+    SC_METHOD(read_side);
+    sensitive << rclk.pos();
+    dont_initialize();
+  }
+
+  void set_source_honors_ready(bool en) { honors_ready_ = en; }
+
+  // Counters (for domain utilization reports)
+  uint64_t wcycles() const { return wcycles_; }
+  uint64_t rcycles() const { return rcycles_; }
+  uint64_t pushes()  const { return pushes_; }
+  uint64_t pops()    const { return pops_; }
+
+  void report() const {
+    const double wr_util = wcycles_ ? 100.0 * (double)pushes_ / (double)wcycles_ : 0.0;
+    const double rd_util = rcycles_ ? 100.0 * (double)pops_   / (double)rcycles_ : 0.0;
+    const double occ_avg = wcycles_ ? (double)occ_sum_ / (double)wcycles_ : 0.0;
+    std::cout << "[AFIFO] " << name() << " depth=" << depth_ << " sync=" << sync_
+              << " wr_util=" << wr_util << "% rd_util=" << rd_util << "%"
+              << " occ_avg=" << occ_avg << " occ_peak=" << occ_peak_
+              << " overflow=" << overflow_ << "\n";
+  }
+
+private:
+  struct Entry { T data; bool last; uint64_t visible_at; };
+
+  const unsigned depth_;
+  const unsigned sync_;
+
+  std::deque<Entry>    q_;
+  std::deque<uint64_t> freed_;      // wclk cycle at which a pop becomes visible to the writer
+  bool presented_ = false;
+  bool honors_ready_ = true;
+  bool ready_q1_ = false, ready_q2_ = false;   // ready driven 1 and 2 wclk edges ago
+
+  uint64_t wcycles_ = 0, rcycles_ = 0;
+  uint64_t pushes_  = 0, pops_    = 0;
+  uint64_t overflow_ = 0;
+  uint64_t occ_sum_  = 0;
+  size_t   occ_peak_ = 0;
+
+  void write_side() {
+    ++wcycles_;
+    while (!freed_.empty() && wcycles_ >= freed_.front()) freed_.pop_front();
+
+    // Occupancy as seen through the read-pointer synchronizer
+    const size_t seen = q_.size() + freed_.size();
+    // A ready source re-presents the beat until it sees ready; only the beat
+    // presented against the ready we drove two edges ago is new.
+    const bool offered = valid_in.read() && (!honors_ready_ || ready_q2_);
+    if (offered) {
+      if (seen < depth_) {
+        q_.push_back(Entry{data_in.read(), last_in.read(), rcycles_ + sync_});
+        ++pushes_;
+      } else {
+        ++overflow_;
+      }
+    }
+    const bool rdy = q_.size() + freed_.size() + 1 < depth_;
+    ready_out.write(rdy);
+    ready_q2_ = ready_q1_;
+    ready_q1_ = rdy;
+
+    occ_sum_ += q_.size();
+    occ_peak_ = std::max(occ_peak_, q_.size());
+  }
+
+  void read_side() {
+    ++rcycles_;
+    if (presented_ && ready_in.read()) {
+      q_.pop_front();
+      freed_.push_back(wcycles_ + sync_);
+      ++pops_;
+    }
+    presented_ = !q_.empty() && rcycles_ >= q_.front().visible_at;
+    if (presented_) {
+      data_out.write(q_.front().data);
+      last_out.write(q_.front().last);
+      valid_out.write(true);
+    } else {
+      valid_out.write(false);
+      last_out.write(false);
+    }
+  }
+};
@@ -143,3 +143,12 @@ bool load_bmp_grayscale(const std::string& path, int& W, int& H, std::vector<uin
     return true;
 }
 
+
+bool write_pgm(const std::string& path, int W, int H, const std::vector<uint8_t>& img) {
+    std::ofstream f(path, std::ios::binary);
+    if (!f) return false;
+    f << "P5\n" << W << " " << H << "\n255\n";
+    f.write(reinterpret_cast<const char*>(img.data()), img.size());
+    std::cout << "Wrote " << path << " (" << W << "x" << H << ")\n";
+    return true;
+}
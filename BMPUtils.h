@@ -7,3 +7,6 @@
 // Returns true on hit. On hit, W,H and 'out' are filled (size = W*H).
 bool load_bmp_grayscale(const std::string& path, int& W, int& H, std::vector<uint8_t>& out);
 
+// Simple binary PGM (P5) writer.
+bool write_pgm(const std::string& path, int W, int H, const std::vector<uint8_t>& img);
+
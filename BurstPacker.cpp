@@ -11,6 +11,7 @@ BurstPacker::BurstPacker(sc_core::sc_module_name n)
   ready_out("ready_out"),
   burst_out("burst_out"),
   burst_valid("burst_valid"),
+  burst_last("burst_last"),
   burst_ready("burst_ready")
 {
     SC_METHOD(run);
@@ -21,22 +22,34 @@ BurstPacker::BurstPacker(sc_core::sc_module_name n)
 void BurstPacker::run() {
    
     bool can_accept = true;
+    if (perf_) {
+        pclk_.edge();
+        if (hold_valid_) ++hold_cycles_;              // hold slot occupied this cycle
+    }
 
     // If we are holding a burst that hasn't been accepted yet,
     // present it and stall upstream until burst_ready is true.
     if (hold_valid_) {
         burst_out.write(hold_data_);
         burst_valid.write(true);
+        burst_last.write(hold_last_);
         can_accept = burst_ready.read();      // only accept new pixels if the burst was taken
         if (burst_ready.read()) {
             hold_valid_ = false;              // accepted this cycle
         }
     } else {
         burst_valid.write(false);
+        burst_last.write(false);
     }
 
-    // Upstream backpressure
-    ready_out.write(can_accept);
+    // Upstream backpressure. A registered-ready source (the pixel CDC FIFO)
+    // pops against the ready we drove last edge, so take pixels on that one.
+    if (registered_ready_) can_accept = ready_q1_;
+    else                   ready_out.write(can_accept);
+    if (perf_) {
+        if (valid_in.read() && !can_accept) ++stall_cycles_;
+        if (hold_valid_ || valid_in.read()) ++busy_cycles_;
+    }
 
     // Accept a pixel if upstream is sending and we can take it
     if (can_accept && valid_in.read()) {
@@ -45,25 +58,55 @@ void BurstPacker::run() {
         // pack into lane [8*count_ +: 8]
         shreg_.range(8*count_ + 7, 8*count_) = bb;
         count_++;
+        if (energy_) { ++energy_->c.pack_pix; ++e_frame_pix_; }
 
-        // Emit a burst when 32 bytes are packed
-        if (count_ == 32) {
+        // Emit a burst when 32 bytes are packed, or flush a zero-padded
+        // partial burst on the last pixel of the frame (vsync)
+        const bool last = vsync_in.read();
+        if (count_ == 32 || last) {
             // If downstream is ready now and we aren't holding, we can send immediately
             if (!hold_valid_ && burst_ready.read()) {
                 burst_out.write(shreg_);
                 burst_valid.write(true);
+                burst_last.write(last);
                 // consumed immediately; next cycle we deassert valid
             } else {
                 // Hold the burst for a later cycle
                 hold_data_  = shreg_;
+                hold_last_  = last;
                 hold_valid_ = true;
             }
             // reset the packer for next burst
             shreg_ = 0;
             count_ = 0;
+
+            if (energy_) {
+                ++energy_->c.pack_beats;
+                if (last) { energy_->frame_written(e_frame_pix_); e_frame_pix_ = 0; }
+            }
+
+            if (perf_) {
+                ++beats_;
+                if (last) {
+                    const sc_core::sc_time now = sc_core::sc_time_stamp();
+                    const double period_ns = have_vs_ ? (now - t_vs_).to_seconds() * 1e9 : 0.0;
+                    perf_->record("packer", ++frame_, pclk_.cycles(busy_cycles_),
+                                  { {"beats", (double)beats_},
+                                    {"hold_cycles", (double)hold_cycles_},
+                                    {"stall_cycles", (double)stall_cycles_},
+                                    {"vsync_period_ns", period_ns} });
+                    beats_ = busy_cycles_ = hold_cycles_ = stall_cycles_ = 0;
+                    t_vs_ = now; have_vs_ = true;
+                }
+            }
         }
     }
 
-    (void)vsync_in.read();
+    // Registered ready: promise the next edge's pixel only with the hold slot
+    // free, so a burst completed by that pixel always has somewhere to go
+    if (registered_ready_) {
+        ready_q1_ = !hold_valid_;
+        ready_out.write(ready_q1_);
+    }
 }
 
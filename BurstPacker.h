@@ -1,6 +1,8 @@
 #pragma once
 #include <systemc>
 #include <systemc-ams.h>
+#include "PerfCounters.h"
+#include "EnergyModel.h"
 
 struct BurstPacker : sc_core::sc_module {
     // Clk
@@ -15,11 +17,20 @@ struct BurstPacker : sc_core::sc_module {
     // Downstream burst interface (256-bit)
     sc_core::sc_out< sc_dt::sc_bv<256> > burst_out;    // 32 bytes per burst
     sc_core::sc_out<bool>                burst_valid;  // burst_out is valid
+    sc_core::sc_out<bool>                burst_last;   // last beat of the frame (flushed on vsync)
     sc_core::sc_in<bool>                 burst_ready;  // downstream can take it
 
     SC_HAS_PROCESS(BurstPacker);
     BurstPacker(sc_core::sc_module_name n);
 
+    // Per-frame counters (hold-slot occupancy, upstream stalls) at vsync
+    void set_perf(PerfCounters* p) { perf_ = p; }
+    // Per-pixel/beat activity; notes the frame's bytes on the last beat
+    void set_energy(EnergyMeter* e) { energy_ = e; }
+    // Source pops against the ready it saw (driven one edge earlier), as
+    // AsyncFifo does: accept on that ready, not on this edge's burst_ready
+    void set_registered_ready(bool en) { registered_ready_ = en; }
+
 private:
     void run();
 
@@ -28,6 +39,21 @@ private:
 
     // Keep a single pending valid burst if downstream stalls
     bool              hold_valid_ = false;
+    bool              hold_last_  = false;
     sc_dt::sc_bv<256> hold_data_{};
+
+    bool              registered_ready_ = false;
+    bool              ready_q1_ = false;   // ready driven last edge
+
+    // Perf counters
+    PerfCounters*     perf_ = nullptr;
+    PerfClock         pclk_;
+    uint64_t          frame_ = 0, beats_ = 0;
+    uint64_t          busy_cycles_ = 0, hold_cycles_ = 0, stall_cycles_ = 0;
+    sc_core::sc_time  t_vs_;
+    bool              have_vs_ = false;
+
+    EnergyMeter*      energy_ = nullptr;
+    uint64_t          e_frame_pix_ = 0;
 };
 
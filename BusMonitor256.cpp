@@ -0,0 +1,122 @@
+#include "BusMonitor256.h"
+#include <algorithm>
+#include <iostream>
+using sc_core::sc_time;
+using sc_core::sc_time_stamp;
+
+static inline uint64_t to_ps(const sc_time& t) { return (uint64_t)(t.to_seconds() * 1e12 + 0.5); }
+
+BusMonitor256::BusMonitor256(sc_core::sc_module_name name, sc_time window,
+                             unsigned ring_windows, unsigned bytes_per_beat)
+: sc_module(name), clk("clk"), valid_in("valid_in"), ready_in("ready_in"),
+  window_(window), bpb_(bytes_per_beat), ring_(ring_windows ? ring_windows : 1) {
+  SC_CTHREAD(run, clk.pos());
+}
+
+bool BusMonitor256::set_dump_path(const std::string& path) {
+  bin_ = path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+  dump_.open(path, bin_ ? std::ios::binary : std::ios::out);
+  if (!dump_) return false;
+  if (bin_) {
+    const uint32_t bpb = bpb_;
+    const uint64_t wps = to_ps(window_);
+    dump_.write("BMON", 4);
+    dump_.write(reinterpret_cast<const char*>(&bpb), 4);
+    dump_.write(reinterpret_cast<const char*>(&wps), 8);
+  } else {
+    dump_ << "t_ns,cycles,beats,util,gbps\n";
+  }
+  return true;
+}
+
+void BusMonitor256::commit(const Sample& s) {
+  ring_[head_] = s;
+  head_ = (head_ + 1) % ring_.size();
+  if (count_ < ring_.size()) ++count_;
+
+  if (!dump_) return;
+  if (bin_) {
+    dump_.write(reinterpret_cast<const char*>(&s.t_ps), 8);
+    dump_.write(reinterpret_cast<const char*>(&s.cycles), 4);
+    dump_.write(reinterpret_cast<const char*>(&s.beats), 4);
+  } else {
+    const double dt_s = s.cycles * period_.to_seconds();
+    dump_ << s.t_ps / 1000.0 << "," << s.cycles << "," << s.beats << ","
+          << (s.cycles ? (double)s.beats / s.cycles : 0.0) << ","
+          << (dt_s > 0 ? (double)s.beats * bpb_ / (dt_s * 1e9) : 0.0) << "\n";
+  }
+}
+
+// Idle windows are held back until the next busy one, so a bus that has
+// finished does not report its trailing silence.
+void BusMonitor256::close_window() {
+  if (cur_.beats == 0) { ++pending_idle_; return; }
+  const uint32_t idle_cycles = (period_.value() > 0) ? (uint32_t)(window_ / period_ + 0.5) : 0;
+  for (uint64_t k = pending_idle_; k > 0; --k)
+    commit(Sample{cur_.t_ps - k * to_ps(window_), idle_cycles, 0});
+  pending_idle_ = 0;
+  commit(cur_);
+}
+
+void BusMonitor256::run() {
+  wait();
+  for (;;) {
+    const sc_time now = sc_time_stamp();
+    if (now > last_edge_) period_ = now - last_edge_;
+    last_edge_ = now;
+
+    const bool xfer = valid_in.read() && ready_in.read();
+    if (!started_ && xfer) {
+      started_ = true;
+      win_t0_  = now;
+      cur_     = Sample{to_ps(now), 0, 0};
+    }
+    if (started_) {
+      while (now >= win_t0_ + window_) {
+        close_window();
+        win_t0_ += window_;
+        cur_ = Sample{to_ps(win_t0_), 0, 0};
+      }
+      ++cur_.cycles;
+      ++cycle_;
+      if (xfer) {
+        ++cur_.beats;
+        if (beats_++ > 0) max_gap_ = std::max<uint64_t>(max_gap_, cycle_ - last_xfer_ - 1);
+        last_xfer_ = cycle_;
+      }
+    }
+    wait();
+  }
+}
+
+void BusMonitor256::report() {
+  if (cur_.beats) close_window();   // partial last window
+  cur_.beats = 0;
+  if (!count_) return;
+
+  // ring contents, oldest first (order does not matter for the statistics)
+  std::vector<double> util;
+  util.reserve(count_);
+  double peak_gbps = 0.0;
+  for (size_t i = 0; i < count_; ++i) {
+    const Sample& s = ring_[i];
+    util.push_back(s.cycles ? (double)s.beats / s.cycles : 0.0);
+    const double dt_s = s.cycles * period_.to_seconds();
+    if (dt_s > 0) peak_gbps = std::max(peak_gbps, (double)s.beats * bpb_ / (dt_s * 1e9));
+  }
+  std::sort(util.begin(), util.end());
+  double mean = 0.0;
+  for (double u : util) mean += u;
+  mean /= (double)util.size();
+  const double p99 = util[std::min(util.size() - 1, (size_t)(0.99 * (util.size() - 1) + 0.5))];
+
+  const double span_s = last_xfer_ * period_.to_seconds();
+  const double sustained = span_s > 0 ? (double)beats_ * bpb_ / (span_s * 1e9) : 0.0;
+
+  std::cout << "[BUSMON] " << basename() << " windows=" << count_ << " (" << window_ << ")"
+            << " util min/mean/p99/max=" << 100.0 * util.front() << "/" << 100.0 * mean << "/"
+            << 100.0 * p99 << "/" << 100.0 * util.back() << " %"
+            << " peak=" << peak_gbps << " GB/s sustained=" << sustained << " GB/s"
+            << " longest_idle=" << max_gap_ << " cycles (" << period_ * (double)max_gap_ << ")\n";
+  if (dump_) dump_.flush();
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <systemc>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Passive bandwidth monitor for a valid/ready 256-bit interface. Counts
+// transfers (valid && ready at the clock edge) per time window and keeps the
+// windows in a ring buffer for min/mean/p99/max utilization; also tracks the
+// longest idle gap between transfers. Windows are counted from the first
+// transfer; trailing idle windows after the last transfer are not reported.
+// Closed windows can be streamed to a CSV (or ".bin": 16-byte header
+// "BMON", u32 bytes/beat, u64 window_ps; then u64 t_ps, u32 cycles, u32 beats).
+struct BusMonitor256 : sc_core::sc_module {
+  sc_core::sc_in<bool> clk;
+  sc_core::sc_in<bool> valid_in;
+  sc_core::sc_in<bool> ready_in;
+
+  SC_HAS_PROCESS(BusMonitor256);
+  BusMonitor256(sc_core::sc_module_name name,
+                sc_core::sc_time window = sc_core::sc_time(1, sc_core::SC_US),
+                unsigned ring_windows = 65536, unsigned bytes_per_beat = 32);
+
+  bool set_dump_path(const std::string& path);
+  void report();                  // closes the open window, prints [BUSMON]
+
+private:
+  struct Sample {
+    uint64_t t_ps;                // window start
+    uint32_t cycles;
+    uint32_t beats;
+  };
+
+  const sc_core::sc_time window_;
+  const unsigned         bpb_;
+  std::vector<Sample>    ring_;
+  size_t   head_ = 0, count_ = 0;
+
+  // Open window
+  Sample   cur_{0, 0, 0};
+  uint64_t pending_idle_ = 0;     // closed idle windows not yet committed
+  bool     started_ = false;
+  sc_core::sc_time win_t0_;
+
+  // Totals / idle gaps (cycles since the first transfer)
+  uint64_t cycle_ = 0, last_xfer_ = 0, beats_ = 0;
+  uint64_t max_gap_ = 0;
+  sc_core::sc_time period_, last_edge_;
+
+  std::ofstream dump_;
+  bool          bin_ = false;
+
+  void run();
+  void close_window();
+  void commit(const Sample& s);
+};
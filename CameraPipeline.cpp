@@ -0,0 +1,98 @@
+#include "CameraPipeline.h"
+#include "BMPUtils.h"
+#include <iostream>
+#include <sstream>
+
+bool parse_camera_spec(const std::string& spec, CameraConfig& cfg) {
+  std::stringstream ss(spec);
+  std::string kv;
+  while (std::getline(ss, kv, ',')) {
+    if (kv.empty()) continue;
+    const size_t eq = kv.find('=');
+    const std::string k = kv.substr(0, eq);
+    const std::string v = (eq == std::string::npos) ? "1" : kv.substr(eq + 1);
+    if      (k == "image")  cfg.image = v;
+    else if (k == "lut")    cfg.lut   = v;
+    else if (k == "gamma")  cfg.gamma = std::stod(v);
+    else if (k == "gain")   cfg.gain  = std::stod(v);
+    else if (k == "offset") cfg.offset = std::stod(v);
+    else if (k == "bypass") cfg.bypass_isp = (v != "0");
+    else if (k == "weight") cfg.weight = (unsigned)std::stoul(v);
+    else if (k == "prio")   cfg.prio   = (unsigned)std::stoul(v);
+    else {
+      std::cerr << "[WARN] Unknown camera key '" << k << "'\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool load_camera_image(const CameraConfig& cfg, int& W, int& H, std::vector<uint8_t>& image) {
+  if (!cfg.image.empty()) return load_bmp_grayscale(cfg.image, W, H, image);
+  W = 32; H = 32;
+  image.resize(W*H);
+  for (int i = 0; i < W*H; ++i) image[i] = static_cast<uint8_t>(i % 256);
+  return true;
+}
+
+CameraPipeline::CameraPipeline(sc_core::sc_module_name name, const CameraConfig& cfg,
+                               const std::vector<uint8_t>& image, int W, int H)
+: sc_module(name),
+  clk("clk"),
+  burst_out("burst_out"),
+  burst_valid("burst_valid"),
+  burst_last("burst_last"),
+  burst_ready("burst_ready"),
+  W_(W), H_(H),
+  sensor_ ("sensor",  image),
+  wrapper_("wrapper", W, H),
+  isp_    ("isp",     W, H),
+  lut_    ("lut"),
+  packer_ ("packer")
+{
+  // AMS → DE
+  sensor_.out(analog_sig_);
+  wrapper_.analog_in(analog_sig_);
+  wrapper_.pixel_out(adc_pix_);
+  wrapper_.valid_out(adc_vld_);
+  wrapper_.hsync_out(adc_hs_);
+  wrapper_.vsync_out(adc_vs_);
+
+  // ISP always bound
+  isp_.clk(clk);
+  isp_.pix_in(adc_pix_);
+  isp_.valid_in(adc_vld_);
+  isp_.vsync_in(adc_vs_);
+  isp_.pix_out(isp_pix_);
+  isp_.valid_out(isp_vld_);
+  isp_.vsync_out(isp_vs_);
+
+  // ISP vs bypass feeding the LUT
+  lut_.clk(clk);
+  lut_.pix_in  (cfg.bypass_isp ? adc_pix_ : isp_pix_);
+  lut_.valid_in(cfg.bypass_isp ? adc_vld_ : isp_vld_);
+  lut_.vsync_in(cfg.bypass_isp ? adc_vs_  : isp_vs_);
+  lut_.pix_out(lut_pix_);
+  lut_.valid_out(lut_vld_);
+  lut_.vsync_out(lut_vs_);
+
+  lut_.load_identity();
+  if (!cfg.lut.empty()) {
+    if (!lut_.load_lut_file(cfg.lut))
+      std::cerr << "[LUT] " << basename() << ": failed to load '" << cfg.lut << "'. Using identity.\n";
+  } else {
+    if (cfg.gain != 1.0 || cfg.offset != 0.0) lut_.apply_gain_offset(cfg.gain, cfg.offset);
+    if (cfg.gamma > 0.0)                       lut_.apply_gamma(cfg.gamma);
+  }
+
+  // Packer → external write port
+  packer_.clk(clk);
+  packer_.pix_in(lut_pix_);
+  packer_.valid_in(lut_vld_);
+  packer_.vsync_in(lut_vs_);
+  packer_.burst_out(burst_out);
+  packer_.burst_valid(burst_valid);
+  packer_.burst_last(burst_last);
+  packer_.burst_ready(burst_ready);
+  packer_.ready_out(packer_ready_sink_);
+}
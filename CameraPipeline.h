@@ -0,0 +1,63 @@
+#pragma once
+#include <systemc>
+#include <systemc-ams.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Sensor.h"
+#include "CannyEdgeWrapper.h"
+#include "ISP_Canny.h"
+#include "Lut1D_DE.h"
+#include "BurstPacker.h"
+
+// Per-camera settings for the multi-camera top.
+// CLI form: --cam=image=a.bmp,bypass=1,gamma=2.2,gain=1,offset=0,lut=x.csv,weight=2,prio=0
+struct CameraConfig {
+  std::string image;            // empty => synthetic ramp
+  std::string lut;              // post-ISP LUT CSV
+  double   gamma  = 0.0;
+  double   gain   = 1.0;
+  double   offset = 0.0;
+  bool     bypass_isp = false;
+  unsigned weight = 1;          // arbiter WRR weight
+  unsigned prio   = 0;          // arbiter strict priority (0 = highest)
+};
+
+bool parse_camera_spec(const std::string& spec, CameraConfig& cfg);
+
+// One sensor → ADC → ISP (or bypass) → LUT → packer chain ending in a
+// 256-bit write port. Frame geometry comes from the camera's own image.
+struct CameraPipeline : sc_core::sc_module {
+  sc_core::sc_in<bool>                 clk;
+
+  sc_core::sc_out< sc_dt::sc_bv<256> > burst_out;
+  sc_core::sc_out<bool>                burst_valid;
+  sc_core::sc_out<bool>                burst_last;
+  sc_core::sc_in<bool>                 burst_ready;
+
+  CameraPipeline(sc_core::sc_module_name name, const CameraConfig& cfg,
+                 const std::vector<uint8_t>& image, int W, int H);
+
+  int width()  const { return W_; }
+  int height() const { return H_; }
+
+private:
+  const int W_, H_;
+
+  cmos_sensor      sensor_;
+  CannyEdgeWrapper wrapper_;
+  ISP_Canny        isp_;
+  Lut1D_DE         lut_;
+  BurstPacker      packer_;
+
+  sca_tdf::sca_signal<double>             analog_sig_;
+  sc_core::sc_signal< sc_dt::sc_uint<8> > adc_pix_, isp_pix_, lut_pix_;
+  sc_core::sc_signal<bool>                adc_vld_, adc_hs_, adc_vs_;
+  sc_core::sc_signal<bool>                isp_vld_, isp_vs_;
+  sc_core::sc_signal<bool>                lut_vld_, lut_vs_;
+  sc_core::sc_signal<bool>                packer_ready_sink_;
+};
+
+// Load a camera image (or build the default 32x32 ramp).
+bool load_camera_image(const CameraConfig& cfg, int& W, int& H, std::vector<uint8_t>& image);
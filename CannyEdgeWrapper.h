@@ -3,7 +3,7 @@
 #include <systemc>
 #include <cstdint>
 #include <string>
-#include "IdentityLUT.h"
+#include "AdcFrontEnd.h"
 
 // TDF module: analog_in (double) -> quantize 8b -> apply 1D LUT -> DE bridge
 // Guarantees exactly W*H valid cycles per frame.
@@ -19,7 +19,8 @@ struct CannyEdgeWrapper : sca_tdf::sca_module {
   sca_tdf::sca_de::sca_out<bool>                   vsync_out;
 
   // Ctor
-  CannyEdgeWrapper(sc_core::sc_module_name nm, int W, int H);
+  CannyEdgeWrapper(sc_core::sc_module_name nm, int W, int H,
+                   sc_core::sc_time Ts = sc_core::sc_time(10, sc_core::SC_NS));
 
   // AMS hooks
   void set_attributes() override;
@@ -32,14 +33,14 @@ struct CannyEdgeWrapper : sca_tdf::sca_module {
   void apply_gamma(double gamma);
   bool dump_lut(const std::string& path) const;
 
+  // Fused ISP-bypass path (see AdcFrontEnd)
+  void fuse_post_lut(const Lut1DTable& post) { fe_.fuse_post_lut(post); }
+  LutHistStats& fused_stats() { return fe_.fused_stats(); }
+  AdcFrontEnd&  front_end()   { return fe_; }
+
 private:
-  // Geometry
-  const int W_;
-  const int H_;
-  const int N_;            // total pixels per frame
-  int       idx_ = 0;      // 0 .. N_-1 (position inside frame)
+  const sc_core::sc_time Ts_;   // TDF timestep = sensor/ISP clock period
 
-  // LUT
-  IdentityLUT lut_;
+  // Quantizer + LUT + syncs
+  AdcFrontEnd fe_;
 };
-
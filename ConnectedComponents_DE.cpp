@@ -0,0 +1,215 @@
+#include "ConnectedComponents_DE.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static inline void put16(std::vector<uint8_t>& o, uint32_t v) {
+  o.push_back((uint8_t)v); o.push_back((uint8_t)(v >> 8));
+}
+static inline void put32(std::vector<uint8_t>& o, uint32_t v) {
+  put16(o, v & 0xffff); put16(o, v >> 16);
+}
+static inline uint32_t get16(const uint8_t* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8); }
+static inline uint32_t get32(const uint8_t* p) { return get16(p) | (get16(p + 2) << 16); }
+
+size_t ccl_max_bytes(int W, int H) {
+  const size_t comps = (size_t)((W + 1) / 2) * (size_t)((H + 1) / 2);
+  return CCL_HEADER_BYTES + comps * CCL_RECORD_BYTES + CCL_TRAILER_BYTES;
+}
+
+bool ccl_decode(const std::vector<uint8_t>& b, std::vector<CclComponent>& out) {
+  out.clear();
+  if (b.size() < CCL_HEADER_BYTES || std::memcmp(b.data(), "CCL1", 4) != 0) return false;
+  size_t p = CCL_HEADER_BYTES;
+  while (p + 4 <= b.size()) {
+    if (std::memcmp(&b[p], "CEND", 4) == 0)
+      return p + CCL_TRAILER_BYTES <= b.size() && get32(&b[p + 4]) == out.size();
+    if (p + CCL_RECORD_BYTES > b.size()) break;
+    const uint8_t* r = &b[p];
+    out.push_back(CclComponent{ (uint16_t)get16(r), (uint16_t)get16(r + 2),
+                                (uint16_t)get16(r + 4), (uint16_t)get16(r + 6),
+                                get32(r + 8), get32(r + 12), get32(r + 16) });
+    p += CCL_RECORD_BYTES;
+  }
+  return false;   // no trailer
+}
+
+bool write_components_csv(const std::string& path, const std::vector<CclComponent>& comps) {
+  std::ofstream f(path);
+  if (!f) return false;
+  f << "x0,y0,x1,y1,pixels,cx,cy\n";
+  for (const CclComponent& c : comps)
+    f << c.x0 << "," << c.y0 << "," << c.x1 << "," << c.y1 << "," << c.pixels << ","
+      << c.cx_q8 / 256.0 << "," << c.cy_q8 / 256.0 << "\n";
+  return (bool)f;
+}
+
+// ---------------------------------------------------------------- labelling
+
+StreamingCcl::StreamingCcl(int W, int H, uint8_t threshold, uint32_t min_pixels)
+: W_(W), H_(H), thr_(threshold), min_pix_(std::max(1u, min_pixels)),
+  prev_(W, 0), cur_(W, 0), parent_(W + 2, 0), stats_(W + 2), seen_(W + 2, 0) {
+  for (uint32_t l = (uint32_t)W + 1; l >= 1; --l) free_.push_back(l);
+  live_.reserve(W + 1);
+}
+
+uint32_t StreamingCcl::find(uint32_t l) {
+  uint32_t r = l;
+  while (parent_[r] != r) r = parent_[r];
+  while (parent_[l] != r) { const uint32_t n = parent_[l]; parent_[l] = r; l = n; }
+  return r;
+}
+
+uint32_t StreamingCcl::unite(uint32_t a, uint32_t b) {
+  const uint32_t r = std::min(a, b), o = std::max(a, b);
+  Stats& s = stats_[r];
+  const Stats& t = stats_[o];
+  s.x0 = std::min(s.x0, t.x0); s.y0 = std::min(s.y0, t.y0);
+  s.x1 = std::max(s.x1, t.x1); s.y1 = std::max(s.y1, t.y1);
+  s.pixels += t.pixels; s.sx += t.sx; s.sy += t.sy;
+  parent_[o] = r;
+  ++merges_;
+  return r;
+}
+
+uint32_t StreamingCcl::alloc() {
+  // W+1 labels always suffice: live roots of one row plus the current row's
+  const uint32_t l = free_.back();
+  free_.pop_back();
+  parent_[l] = l;
+  stats_[l] = Stats{ (uint32_t)x_, (uint32_t)y_, (uint32_t)x_, (uint32_t)y_, 0, 0, 0 };
+  live_.push_back(l);
+  label_peak_ = std::max(label_peak_, live_.size());
+  return l;
+}
+
+void StreamingCcl::push(uint8_t v, std::vector<uint8_t>& out) {
+  if (!in_frame_) {
+    in_frame_ = true;
+    out.insert(out.end(), { 'C', 'C', 'L', '1' });
+    put16(out, (uint32_t)W_); put16(out, (uint32_t)H_);
+    put32(out, frame_);
+  }
+  if (y_ >= H_) return;   // overlong frame: ignore until vsync
+
+  uint32_t lab = 0;
+  if (v >= thr_) {
+    const uint32_t nb[4] = {
+      x_ > 0 ? cur_[x_ - 1] : 0u,
+      x_ > 0 ? prev_[x_ - 1] : 0u,
+      prev_[x_],
+      x_ + 1 < W_ ? prev_[x_ + 1] : 0u };
+    for (uint32_t n : nb) {
+      if (!n) continue;
+      const uint32_t r = find(n);
+      lab = !lab ? r : (r != lab ? unite(lab, r) : lab);
+    }
+    if (!lab) lab = alloc();
+    Stats& s = stats_[lab];
+    s.x0 = std::min(s.x0, (uint32_t)x_); s.x1 = std::max(s.x1, (uint32_t)x_);
+    s.y1 = (uint32_t)y_;
+    ++s.pixels; s.sx += (uint64_t)x_; s.sy += (uint64_t)y_;
+  }
+  cur_[x_] = lab;
+
+  if (++x_ == W_) { end_row(out); x_ = 0; ++y_; }
+}
+
+void StreamingCcl::end_row(std::vector<uint8_t>& out) {
+  ++stamp_;
+  for (uint32_t& l : cur_)
+    if (l) { l = find(l); seen_[l] = stamp_; }
+
+  // merged labels are unreferenced now; roots not on this row are complete
+  size_t keep = 0;
+  for (uint32_t l : live_) {
+    if (parent_[l] == l && seen_[l] == stamp_) { live_[keep++] = l; continue; }
+    if (parent_[l] == l) emit(l, out);
+    free_.push_back(l);
+  }
+  live_.resize(keep);
+  std::swap(prev_, cur_);
+}
+
+void StreamingCcl::emit(uint32_t root, std::vector<uint8_t>& out) {
+  const Stats& s = stats_[root];
+  if (s.pixels < min_pix_) return;
+  put16(out, s.x0); put16(out, s.y0); put16(out, s.x1); put16(out, s.y1);
+  put32(out, s.pixels);
+  put32(out, (uint32_t)((s.sx * 256 + s.pixels / 2) / s.pixels));
+  put32(out, (uint32_t)((s.sy * 256 + s.pixels / 2) / s.pixels));
+  ++records_;
+}
+
+uint32_t StreamingCcl::end_frame(std::vector<uint8_t>& out) {
+  if (!in_frame_) return 0;
+  if (x_ > 0) {                     // short row: background for the rest
+    std::fill(cur_.begin() + x_, cur_.end(), 0u);
+    end_row(out);
+  }
+  for (uint32_t l : live_) { if (parent_[l] == l) emit(l, out); free_.push_back(l); }
+  live_.clear();
+  out.insert(out.end(), { 'C', 'E', 'N', 'D' });
+  put32(out, records_);
+
+  const uint32_t n = records_;
+  std::fill(prev_.begin(), prev_.end(), 0u);
+  x_ = y_ = 0;
+  records_ = 0;
+  ++frame_;
+  in_frame_ = false;
+  return n;
+}
+
+// ---------------------------------------------------------------- module
+
+ConnectedComponents_DE::ConnectedComponents_DE(sc_core::sc_module_name name, int W, int H,
+                                               uint8_t threshold, uint32_t min_pixels)
+: sc_module(name), clk("clk"), pix_in("pix_in"), valid_in("valid_in"), vsync_in("vsync_in"),
+  pix_out("pix_out"), valid_out("valid_out"), vsync_out("vsync_out"),
+  ccl_(W, H, threshold, min_pixels), W_(W), H_(H) {
+  SC_METHOD(step);
+  sensitive << clk.pos();
+}
+
+void ConnectedComponents_DE::step() {
+  // Ingest one pixel
+  scratch_.clear();
+  if (valid_in.read()) {
+    ccl_.push((uint8_t)pix_in.read().to_uint(), scratch_);
+    ++pixels_;
+    ++frame_pix_;
+  }
+  if (vsync_in.read() && frame_pix_) {
+    records_ += ccl_.end_frame(scratch_);
+    ++frames_;
+    frame_pix_ = 0;
+  }
+  if (!scratch_.empty()) {
+    for (uint8_t b : scratch_) fifo_.emplace_back(b, false);
+    bytes_ += scratch_.size();
+    if (vsync_in.read()) fifo_.back().second = true;   // trailer ends the frame
+  }
+  fifo_peak_ = std::max(fifo_peak_, fifo_.size());
+
+  // Drain one byte per clock
+  if (!fifo_.empty()) {
+    pix_out.write(fifo_.front().first);
+    valid_out.write(true);
+    vsync_out.write(fifo_.front().second);
+    fifo_.pop_front();
+  } else {
+    valid_out.write(false);
+    vsync_out.write(false);
+  }
+}
+
+void ConnectedComponents_DE::report() const {
+  const uint64_t raw = (uint64_t)frames_ * (uint64_t)W_ * (uint64_t)H_;
+  std::cout << "[CCL] frames=" << frames_ << " components=" << records_
+            << " merges=" << ccl_.merges() << " labels_peak=" << ccl_.label_peak()
+            << "/" << ccl_.label_capacity() << " fifo_peak=" << fifo_peak_ << " B\n";
+  std::cout << "[CCL] record bytes=" << bytes_ << " vs " << raw << " B of edge map ("
+            << (bytes_ ? (double)raw / (double)bytes_ : 0.0) << "x less DRAM/PCIe traffic)\n";
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <systemc>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Connected edge segments of one frame, as decoded from the record stream
+struct CclComponent {
+  uint16_t x0, y0, x1, y1;       // bounding box (inclusive)
+  uint32_t pixels;
+  uint32_t cx_q8, cy_q8;         // centroid, 24.8 fixed point
+};
+
+// Record stream per frame (little-endian):
+//   header : "CCL1", u16 W, u16 H, u32 frame
+//   record : u16 x0, y0, x1, y1, u32 pixels, u32 cx_q8, u32 cy_q8  (20 B)
+//   trailer: "CEND", u32 records
+static constexpr size_t CCL_HEADER_BYTES  = 12;
+static constexpr size_t CCL_RECORD_BYTES  = 20;
+static constexpr size_t CCL_TRAILER_BYTES = 8;
+
+size_t ccl_max_bytes(int W, int H);   // worst case (isolated pixels), LPDDR capacity
+bool   ccl_decode(const std::vector<uint8_t>& bytes, std::vector<CclComponent>& out);
+bool   write_components_csv(const std::string& path, const std::vector<CclComponent>& comps);
+
+// Single-pass 8-connected labelling with a one-row label buffer and a
+// union-find over recycled labels (at most W + 1 live). At the end of each
+// row the row is resolved to root labels; roots that no longer touch the
+// row are complete and emitted, merged labels are freed.
+class StreamingCcl {
+public:
+  StreamingCcl(int W, int H, uint8_t threshold, uint32_t min_pixels);
+
+  // One pixel in raster order; completed records are appended to out
+  void push(uint8_t v, std::vector<uint8_t>& out);
+  // Emit the components still open and the trailer; returns records this frame
+  uint32_t end_frame(std::vector<uint8_t>& out);
+
+  size_t   label_capacity() const { return parent_.size() - 1; }
+  size_t   label_peak() const     { return label_peak_; }
+  uint64_t merges() const         { return merges_; }
+
+private:
+  struct Stats { uint32_t x0, y0, x1, y1, pixels; uint64_t sx, sy; };
+
+  const int      W_, H_;
+  const uint8_t  thr_;
+  const uint32_t min_pix_;
+  std::vector<uint32_t> prev_, cur_;      // labels of the previous / current row (0 = background)
+  std::vector<uint32_t> parent_;          // union-find, index = label
+  std::vector<Stats>    stats_;           // valid at roots
+  std::vector<uint32_t> seen_;            // row stamp per label
+  std::vector<uint32_t> free_, live_;
+  int      x_ = 0, y_ = 0;
+  uint32_t frame_ = 0, records_ = 0, stamp_ = 0;
+  bool     in_frame_ = false;
+  size_t   label_peak_ = 0;
+  uint64_t merges_ = 0;
+
+  uint32_t find(uint32_t l);
+  uint32_t unite(uint32_t a, uint32_t b);
+  uint32_t alloc();
+  void     end_row(std::vector<uint8_t>& out);
+  void     emit(uint32_t root, std::vector<uint8_t>& out);
+};
+
+// DE stage after the ISP: labels the binary edge map (pixel >= threshold)
+// one pixel per clock and streams the component records, one byte per clock,
+// in place of the frame; vsync_out marks the last byte (packer wlast).
+struct ConnectedComponents_DE : sc_core::sc_module {
+  sc_core::sc_in<bool>                 clk;
+
+  sc_core::sc_in< sc_dt::sc_uint<8> >  pix_in;
+  sc_core::sc_in<bool>                 valid_in;
+  sc_core::sc_in<bool>                 vsync_in;
+
+  sc_core::sc_out< sc_dt::sc_uint<8> > pix_out;
+  sc_core::sc_out<bool>                valid_out;
+  sc_core::sc_out<bool>                vsync_out;
+
+  SC_HAS_PROCESS(ConnectedComponents_DE);
+  ConnectedComponents_DE(sc_core::sc_module_name name, int W, int H,
+                         uint8_t threshold = 128, uint32_t min_pixels = 1);
+
+  void report() const;
+
+private:
+  StreamingCcl ccl_;
+  std::vector<uint8_t> scratch_;
+  std::deque< std::pair<uint8_t,bool> > fifo_;   // (byte, last-of-frame)
+  size_t   fifo_peak_ = 0;
+  uint64_t frames_ = 0, pixels_ = 0, records_ = 0, bytes_ = 0;
+  uint32_t frame_pix_ = 0;
+  const int W_, H_;
+
+  void step();  // posedge clocked
+};
@@ -0,0 +1,24 @@
+#include "DigitalSensor_DE.h"
+#include "Log.h"
+
+DigitalSensor_DE::DigitalSensor_DE(sc_core::sc_module_name nm, const std::vector<uint8_t>& img,
+                                   int W, int H)
+: sc_module(nm), clk("clk"), pixel_out("pixel_out"), valid_out("valid_out"),
+  hsync_out("hsync_out"), vsync_out("vsync_out"), image_(img), fe_(W, H) {
+  SC_METHOD(step);
+  sensitive << clk.pos();
+  dont_initialize();
+  ro_.configure(ReadoutMode(), (int)image_.size(), 1);
+  ISP_LOG(LOG_INFO, LOGC_SENSOR, "Loaded " << image_.size() << " pixels from host image (digital source).");
+}
+
+void DigitalSensor_DE::step() {
+  // cmos_sensor sample: the (binned) pixel value, 0.0 once the image is exhausted
+  const double vin = (idx_ < ro_.samples()) ? ro_.sample(image_, idx_++) : 0.0;
+  const AdcSample s = fe_.step(vin);
+
+  pixel_out.write(sc_dt::sc_uint<8>(s.pix));
+  valid_out.write(true);
+  hsync_out.write(s.hsync);
+  vsync_out.write(s.vsync);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <systemc>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AdcFrontEnd.h"
+#include "SensorReadout.h"
+
+// DE-only replacement for cmos_sensor + CannyEdgeWrapper when no analog
+// effects are modelled: one sample per clock, same AdcFrontEnd quantizer/LUT
+// and syncs, no AMS cluster or converter ports. Sample n is driven at edge n
+// (the AMS path writes it at t = n*Ts), so downstream sees identical cycles.
+// After the image the source keeps streaming frames of 0-valued samples,
+// like the analog sensor.
+struct DigitalSensor_DE : sc_core::sc_module {
+  sc_core::sc_in<bool>                 clk;
+  sc_core::sc_out< sc_dt::sc_uint<8> > pixel_out;
+  sc_core::sc_out<bool>                valid_out;
+  sc_core::sc_out<bool>                hsync_out;
+  sc_core::sc_out<bool>                vsync_out;
+
+  SC_HAS_PROCESS(DigitalSensor_DE);
+  DigitalSensor_DE(sc_core::sc_module_name nm, const std::vector<uint8_t>& img, int W, int H);
+
+  // Readout mode on the full-array image; W x H above is the readout geometry
+  void set_readout(const SensorReadout& r) { ro_ = r; }
+
+  // LUT API (same as CannyEdgeWrapper)
+  void load_identity()                              { fe_.lut().reset_identity(); }
+  bool load_lut_file(const std::string& path)       { return fe_.lut().load_csv(path.c_str()); }
+  void apply_gain_offset(double gain, double offset){ fe_.lut().compose_gain_offset(gain, offset); }
+  void apply_gamma(double gamma)                    { fe_.lut().compose_gamma(gamma); }
+  bool dump_lut(const std::string& path) const      { return fe_.lut().dump_csv(path.c_str()); }
+
+  void fuse_post_lut(const Lut1DTable& post) { fe_.fuse_post_lut(post); }
+  LutHistStats& fused_stats() { return fe_.fused_stats(); }
+  AdcFrontEnd&  front_end()   { return fe_; }
+
+private:
+  std::vector<uint8_t> image_;
+  SensorReadout        ro_;
+  std::size_t idx_ = 0;
+  AdcFrontEnd fe_;
+
+  void step();
+};
@@ -0,0 +1,138 @@
+#include "DmaDescriptor.h"
+#include <iostream>
+#include <sstream>
+
+static bool parse_dims(const std::string& v, uint32_t& a, uint32_t& b) {
+  const size_t x = v.find('x');
+  if (x == std::string::npos) return false;
+  a = (uint32_t)std::stoul(v.substr(0, x));
+  b = (uint32_t)std::stoul(v.substr(x + 1));
+  return a > 0 && b > 0;
+}
+
+bool parse_dma_spec(const std::string& spec, DmaConfig& cfg) {
+  std::stringstream ss(spec);
+  std::string kv;
+  while (std::getline(ss, kv, ',')) {
+    if (kv.empty()) continue;
+    const size_t eq = kv.find('=');
+    const std::string k = kv.substr(0, eq);
+    const std::string v = (eq == std::string::npos) ? "" : kv.substr(eq + 1);
+    bool ok = true;
+    if      (k == "base")   cfg.base   = std::stoull(v, nullptr, 0);
+    else if (k == "width")  cfg.width  = (uint32_t)std::stoul(v, nullptr, 0);
+    else if (k == "lines")  cfg.lines  = (uint32_t)std::stoul(v, nullptr, 0);
+    else if (k == "stride") cfg.stride = (uint32_t)std::stoul(v, nullptr, 0);
+    else if (k == "tile")   ok = parse_dims(v, cfg.tile_w, cfg.tile_h);
+    else if (k == "rtile")  ok = parse_dims(v, cfg.rtile_w, cfg.rtile_h);
+    else if (k == "act")    cfg.act_cycles = (unsigned)std::stoul(v);
+    else if (k == "read") {
+      if      (v == "raster")    cfg.order = DmaOrder::Raster;
+      else if (v == "transpose") cfg.order = DmaOrder::Transpose;
+      else if (v == "tile")      cfg.order = DmaOrder::Tile;
+      else ok = false;
+    }
+    else {
+      std::cerr << "[WARN] Unknown dma key '" << k << "'\n";
+      return false;
+    }
+    if (!ok) {
+      std::cerr << "[WARN] Bad dma value '" << kv << "'\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+const char* dma_order_name(DmaOrder o) {
+  switch (o) {
+    case DmaOrder::Transpose: return "transpose";
+    case DmaOrder::Tile:      return "tile";
+    default:                  return "raster";
+  }
+}
+
+bool DmaDescriptor::configure(const DmaConfig& cfg, uint32_t W, uint32_t H) {
+  c_ = cfg;
+  if (!c_.width)  c_.width  = W;
+  if (!c_.lines)  c_.lines  = H;
+  if (!c_.stride) c_.stride = c_.width;
+  if (c_.width != W || c_.lines != H) {
+    std::cerr << "[WARN] DMA region " << c_.width << "x" << c_.lines
+              << " does not match the " << W << "x" << H << " frame\n";
+    return false;
+  }
+  if (c_.stride < c_.width) {
+    std::cerr << "[WARN] DMA stride " << c_.stride << " < line width " << c_.width << "\n";
+    return false;
+  }
+  if (c_.tile_w && (c_.width % c_.tile_w || c_.lines % c_.tile_h)) {
+    std::cerr << "[WARN] DMA tile " << c_.tile_w << "x" << c_.tile_h << " does not divide the frame\n";
+    return false;
+  }
+  if (!c_.rtile_w) {
+    c_.rtile_w = c_.tile_w ? c_.tile_w : 32;
+    c_.rtile_h = c_.tile_w ? c_.tile_h : 8;
+  }
+  if (c_.order == DmaOrder::Tile && (c_.width % c_.rtile_w || c_.lines % c_.rtile_h)) {
+    std::cerr << "[WARN] DMA read tile " << c_.rtile_w << "x" << c_.rtile_h << " does not divide the frame\n";
+    return false;
+  }
+  return true;
+}
+
+uint64_t DmaDescriptor::addr(uint32_t x, uint32_t y) const {
+  if (!c_.tile_w) return c_.base + (uint64_t)y * c_.stride + x;
+  const uint32_t tx = x / c_.tile_w, ty = y / c_.tile_h;
+  const uint64_t tile_bytes = (uint64_t)c_.tile_w * c_.tile_h;
+  return c_.base + (uint64_t)ty * c_.tile_h * c_.stride + tx * tile_bytes
+       + (uint64_t)(y % c_.tile_h) * c_.tile_w + (x % c_.tile_w);
+}
+
+uint64_t DmaDescriptor::read_addr(uint32_t i) const {
+  switch (c_.order) {
+    case DmaOrder::Transpose:
+      return addr(i / c_.lines, i % c_.lines);
+    case DmaOrder::Tile: {
+      const uint32_t tb = c_.rtile_w * c_.rtile_h, t = i / tb, o = i % tb;
+      const uint32_t tpr = c_.width / c_.rtile_w;
+      return addr((t % tpr) * c_.rtile_w + o % c_.rtile_w, (t / tpr) * c_.rtile_h + o / c_.rtile_w);
+    }
+    default:
+      return write_addr(i);
+  }
+}
+
+uint64_t DmaDescriptor::end() const {
+  return c_.base + (uint64_t)(c_.lines - 1) * c_.stride + c_.width;
+}
+
+std::string DmaDescriptor::describe() const {
+  std::ostringstream os;
+  os << "base=0x" << std::hex << c_.base << std::dec << " " << c_.width << "x" << c_.lines
+     << " stride=" << c_.stride;
+  if (c_.tile_w) os << " tiled " << c_.tile_w << "x" << c_.tile_h;
+  else           os << " linear";
+  os << ", read " << dma_order_name(c_.order);
+  if (c_.order == DmaOrder::Tile) os << " " << c_.rtile_w << "x" << c_.rtile_h;
+  return os.str();
+}
+
+void DramAccessStats::access(uint64_t addr, uint32_t row_bytes) {
+  ++bytes;
+  const uint64_t b = addr / 32;
+  if (b != cur_burst_) { ++bursts; cur_burst_ = b; }
+  const uint64_t row = addr / row_bytes;
+  if (row != open_row_) { ++acts; open_row_ = row; }
+}
+
+void DramAccessStats::report(const char* dir, unsigned act_cycles) const {
+  if (!bytes) return;
+  // one cycle per burst plus the row miss penalty, against bytes/32 ideal beats
+  const uint64_t ideal  = (bytes + 31) / 32;
+  const uint64_t cycles = bursts + acts * act_cycles;
+  std::cout << "[DMA] " << dir << " bytes=" << bytes << " beats=" << beats
+            << " bursts=" << bursts << " (" << (100.0 * bytes / (32.0 * bursts)) << "% burst use)"
+            << " row_acts=" << acts << " (" << (100.0 * (1.0 - (double)acts / bursts)) << "% row hits)"
+            << " est_cycles=" << cycles << " efficiency=" << (100.0 * ideal / cycles) << "%\n";
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// 2D DMA descriptor for the LPDDR frame region.
+// CLI form: --dma=base=0x1000,stride=4096,width=640,lines=480,tile=32x8,
+//                 read=raster|transpose|tile,rtile=32x8,act=12
+// The frame (width x lines bytes, raster order on the write bus) is placed
+// at base with a line pitch of stride bytes: stride > width pads the lines,
+// and base/stride inside a larger canvas write a sub-rectangle. With tile=
+// the frame is stored as tw x th tiles, each tile contiguous, tiles in
+// raster order, one row of tiles every th*stride bytes. The read side walks
+// the same region in raster, transposed (column-major) or tile order.
+enum class DmaOrder { Raster, Transpose, Tile };
+
+struct DmaConfig {
+  uint64_t base    = 0;
+  uint32_t width   = 0;               // bytes per line (0: frame width)
+  uint32_t lines   = 0;               // 0: frame height
+  uint32_t stride  = 0;               // line pitch in bytes (0: width)
+  uint32_t tile_w  = 0, tile_h = 0;   // storage tiles (0: linear)
+  DmaOrder order   = DmaOrder::Raster;
+  uint32_t rtile_w = 0, rtile_h = 0;  // read=tile block (0: storage tile, else 32x8)
+  unsigned act_cycles = 12;           // row miss penalty (precharge + activate)
+};
+
+bool parse_dma_spec(const std::string& spec, DmaConfig& cfg);
+const char* dma_order_name(DmaOrder o);
+
+// Address generation for one frame region
+class DmaDescriptor {
+public:
+  bool configure(const DmaConfig& cfg, uint32_t W, uint32_t H);   // false if inconsistent
+
+  uint64_t addr(uint32_t x, uint32_t y) const;       // storage address of pixel (x, y)
+  uint64_t write_addr(uint32_t i) const { return addr(i % c_.width, i / c_.width); }
+  uint64_t read_addr(uint32_t i) const;              // i-th byte in the read order
+  uint64_t end() const;                               // one past the highest address
+  uint32_t bytes() const { return c_.width * c_.lines; }
+  const DmaConfig& config() const { return c_; }
+  std::string describe() const;
+
+private:
+  DmaConfig c_;
+};
+
+// Per-direction DRAM efficiency: 32-byte bursts and open-page row activations
+// actually issued for the bytes moved, against an ideal linear stream.
+struct DramAccessStats {
+  uint64_t bytes = 0, bursts = 0, acts = 0, beats = 0;
+
+  void access(uint64_t addr, uint32_t row_bytes);    // one byte, in stream order
+  void end_beat() { ++beats; cur_burst_ = ~0ull; }   // bursts do not merge across beats
+  void report(const char* dir, unsigned act_cycles) const;
+
+private:
+  uint64_t cur_burst_ = ~0ull, open_row_ = ~0ull;
+};
@@ -0,0 +1,94 @@
+#include "EnergyModel.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "Log.h"
+
+bool EnergyCoeffs::load(const std::string& path) {
+  std::ifstream f(path);
+  if (!f) return false;
+  std::string line;
+  while (std::getline(f, line)) {
+    const size_t hash = line.find('#');
+    if (hash != std::string::npos) line.erase(hash);
+    const size_t eq = line.find('=');
+    if (eq == std::string::npos) continue;
+    std::string key = line.substr(0, eq);
+    key.erase(0, key.find_first_not_of(" \t"));
+    key.erase(key.find_last_not_of(" \t") + 1);
+    std::istringstream vs(line.substr(eq + 1));
+    double v = 0.0;
+    if (!(vs >> v)) continue;
+
+    if      (key == "bus_toggle_pj") bus_toggle_pj = v;
+    else if (key == "dram_act_pj")   dram_act_pj   = v;
+    else if (key == "dram_rd_pj")    dram_rd_pj    = v;
+    else if (key == "dram_wr_pj")    dram_wr_pj    = v;
+    else if (key == "dram_idle_pj")  dram_idle_pj  = v;
+    else if (key == "lut_pixel_pj")  lut_pixel_pj  = v;
+    else if (key == "pack_pixel_pj") pack_pixel_pj = v;
+    else if (key == "pack_beat_pj")  pack_beat_pj  = v;
+    else std::cerr << "[ENERGY] Unknown coefficient '" << key << "' ignored\n";
+  }
+  return true;
+}
+
+static EnergyCounts operator-(const EnergyCounts& a, const EnergyCounts& b) {
+  EnergyCounts d;
+  d.wbus_toggles = a.wbus_toggles - b.wbus_toggles;
+  d.rbus_toggles = a.rbus_toggles - b.rbus_toggles;
+  d.dram_act   = a.dram_act   - b.dram_act;
+  d.dram_rd    = a.dram_rd    - b.dram_rd;
+  d.dram_wr    = a.dram_wr    - b.dram_wr;
+  d.dram_idle  = a.dram_idle  - b.dram_idle;
+  d.lut_pix    = a.lut_pix    - b.lut_pix;
+  d.pack_pix   = a.pack_pix   - b.pack_pix;
+  d.pack_beats = a.pack_beats - b.pack_beats;
+  return d;
+}
+
+double EnergyMeter::energy_pj(const EnergyCounts& n) const {
+  const EnergyCoeffs& k = coeffs;
+  return k.bus_toggle_pj * (double)(n.wbus_toggles + n.rbus_toggles)
+       + k.dram_act_pj   * (double)n.dram_act
+       + k.dram_rd_pj    * (double)n.dram_rd
+       + k.dram_wr_pj    * (double)n.dram_wr
+       + k.dram_idle_pj  * (double)n.dram_idle
+       + k.lut_pixel_pj  * (double)n.lut_pix
+       + k.pack_pixel_pj * (double)n.pack_pix
+       + k.pack_beat_pj  * (double)n.pack_beats;
+}
+
+void EnergyMeter::frame_end(uint64_t frame_bytes) {
+  const sc_core::sc_time now = sc_core::sc_time_stamp();
+  const double e_pj = energy_pj(c - mark_);
+  const double dt_s = (now - t_mark_).to_seconds();
+  ++frames_;
+  bytes_ += frame_bytes;
+  ISP_LOG(LOG_INFO, LOGC_ENERGY, "frame " << frames_ << " bytes=" << frame_bytes
+          << " energy=" << e_pj / 1000.0 << " nJ"
+          << " pJ/byte=" << (frame_bytes ? e_pj / (double)frame_bytes : 0.0)
+          << " power=" << (dt_s > 0 ? e_pj * 1e-12 / dt_s * 1e3 : 0.0) << " mW");
+  mark_   = c;
+  t_mark_ = now;
+}
+
+void EnergyMeter::report() const {
+  const EnergyCoeffs& k = coeffs;
+  const double bus  = k.bus_toggle_pj * (double)(c.wbus_toggles + c.rbus_toggles);
+  const double dram = k.dram_act_pj * (double)c.dram_act + k.dram_rd_pj * (double)c.dram_rd
+                    + k.dram_wr_pj * (double)c.dram_wr + k.dram_idle_pj * (double)c.dram_idle;
+  const double pix  = k.lut_pixel_pj * (double)c.lut_pix + k.pack_pixel_pj * (double)c.pack_pix
+                    + k.pack_beat_pj * (double)c.pack_beats;
+  const double total = bus + dram + pix;
+  const double t_s   = sc_core::sc_time_stamp().to_seconds();
+
+  std::cout << "[ENERGY] toggles wbus=" << c.wbus_toggles << " rbus=" << c.rbus_toggles
+            << " | LPDDR act=" << c.dram_act << " wr=" << c.dram_wr << " rd=" << c.dram_rd
+            << " idle=" << c.dram_idle
+            << " | lut_px=" << c.lut_pix << " pack_px=" << c.pack_pix << " beats=" << c.pack_beats << "\n";
+  std::cout << "[ENERGY] total=" << total / 1000.0 << " nJ (bus " << bus / 1000.0
+            << ", LPDDR " << dram / 1000.0 << ", pixel stages " << pix / 1000.0 << ")"
+            << " pJ/byte=" << (bytes_ ? total / (double)bytes_ : 0.0)
+            << " avg_power=" << (t_s > 0 ? total * 1e-12 / t_s * 1e3 : 0.0) << " mW\n";
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <systemc>
+#include <cstdint>
+#include <string>
+
+// Event-count energy model. Modules given an EnergyMeter* bump the counters
+// below; per-event coefficients (pJ) come from a "key = value" config file.
+// The BurstPacker notes the bytes of each frame it packs; LPDDR closes the
+// frame when its read-out completes, printing energy, pJ/byte and mW for
+// write and read together; report() prints run totals.
+struct EnergyCoeffs {
+  double bus_toggle_pj = 0.08;    // one wire transition on a 256-bit bus
+  double dram_act_pj   = 900.0;   // row activation (incl. precharge)
+  double dram_rd_pj    = 1100.0;  // one 32-byte read beat (array + I/O)
+  double dram_wr_pj    = 1200.0;  // one 32-byte write beat
+  double dram_idle_pj  = 3.0;     // background, per memory clock without a beat
+  double lut_pixel_pj  = 0.4;     // Lut1D_DE lookup + histogram update
+  double pack_pixel_pj = 0.15;    // BurstPacker byte insert
+  double pack_beat_pj  = 4.0;     // BurstPacker 256-bit register/launch
+
+  bool load(const std::string& path);   // unknown keys are warned about
+};
+
+struct EnergyCounts {
+  uint64_t wbus_toggles = 0, rbus_toggles = 0;
+  uint64_t dram_act = 0, dram_rd = 0, dram_wr = 0, dram_idle = 0;
+  uint64_t lut_pix = 0, pack_pix = 0, pack_beats = 0;
+};
+
+class EnergyMeter {
+public:
+  EnergyCoeffs coeffs;
+  EnergyCounts c;                  // incremented by the modules
+
+  static constexpr uint32_t DRAM_ROW_BYTES = 2048;   // open-page row size
+
+  double energy_pj(const EnergyCounts& n) const;
+  void   frame_written(uint64_t frame_bytes) { written_ = frame_bytes; }  // packer: last beat
+  uint64_t written() const { return written_; }
+  void   frame_end(uint64_t frame_bytes);   // per-frame line (deltas since last frame)
+  void   report() const;                    // totals over the run
+
+private:
+  EnergyCounts     mark_;                   // counters at the previous frame end
+  sc_core::sc_time t_mark_;
+  uint64_t         frames_ = 0, bytes_ = 0;
+  uint64_t         written_ = 0;            // bytes of the last packed frame
+};
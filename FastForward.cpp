@@ -0,0 +1,217 @@
+#include "FastForward.h"
+#include "verilated.h"
+#include "VCannyEdge.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static inline uint8_t clamp_u8(int v) {
+  return (uint8_t)std::min(255, std::max(0, v));
+}
+
+// ---- Canny RTL register driver (ISP_Canny compute loop without timing) ----
+// Same register sequence as ISP_Canny in its default mode: every CE/OP
+// strobe edge is followed by an RTL clock tick, so the output is
+// bit-identical to the default out.pgm. 'fast' uses the ISP_LIGHT/ISP_ULTRA
+// sequence instead (strobes evaluated combinationally).
+class CannyRtlModel {
+public:
+  explicit CannyRtlModel(bool fast) : m_(new VCannyEdge), fast_(fast) {}
+  ~CannyRtlModel() { m_->final(); delete m_; }
+
+  void run(const std::vector<uint8_t>& memX, int W, int H, std::vector<uint8_t>& out);
+
+private:
+  VCannyEdge* m_;
+  const bool fast_;
+  int W_ = 0, H_ = 0;
+  std::vector<uint8_t> memXG_, Gxy_, Theta_, nms_;
+
+  inline uint8_t at(const std::vector<uint8_t>& v, int i, int j) const {
+    if (i < 0 || j < 0 || i >= H_ || j >= W_) return 0;
+    return v[static_cast<size_t>(i)*W_ + j];
+  }
+  void tick() {
+    m_->clk = 1; m_->eval();
+    m_->clk = 0; m_->eval();
+  }
+  void reset_rtl() {
+    m_->rst_b = 0; m_->eval(); tick(); tick();
+    m_->rst_b = 1; m_->eval(); tick();
+  }
+  void pulse_ce() {
+    if (fast_) {
+      m_->bCE = 1; m_->eval();
+      m_->bCE = 0; m_->eval();
+    } else {
+      m_->bCE = 1; m_->eval(); tick();
+      m_->bCE = 0; m_->eval(); tick();
+      m_->bCE = 1; m_->eval(); tick();
+    }
+  }
+  void write_reg(int row, int col, uint8_t val) {
+    m_->bWE = 0;
+    m_->dAddrRegRow = row;
+    m_->dAddrRegCol = col;
+    m_->InData      = val;
+    pulse_ce();
+  }
+  uint8_t read_reg(int which) {
+    m_->bWE = 1;
+    m_->dReadReg = which;
+    if (fast_) {
+      pulse_ce();
+      return (uint8_t)m_->OutData;
+    }
+    m_->bCE = 1; m_->eval(); tick();
+    m_->bCE = 0; m_->eval(); tick();
+    const uint8_t v = (uint8_t)m_->OutData;
+    m_->bCE = 1; m_->eval(); tick();
+    return v;
+  }
+  void op_strobe() {
+    m_->bOPEnable = 0; m_->eval(); if (!fast_) tick();
+    m_->bOPEnable = 1; m_->eval(); if (!fast_) tick();
+  }
+};
+
+void CannyRtlModel::run(const std::vector<uint8_t>& memX, int W, int H, std::vector<uint8_t>& out) {
+  W_ = W; H_ = H;
+  const size_t N = (size_t)W * H;
+  memXG_.assign(N, 0); Gxy_.assign(N, 0); Theta_.assign(N, 0); nms_.assign(N, 0);
+  out.assign(N, 0);
+
+  // the SystemC run resets the core once before its (only) frame
+  reset_rtl();
+  m_->bOPEnable = 1;
+  m_->dWriteReg = 0;
+
+  // GAUSSIAN 5x5 (border copied through)
+  m_->OPMode = 0;
+  for (int i=0; i<H; ++i)
+    for (int j=0; j<W; ++j) {
+      if (i<2 || j<2 || i>=H-2 || j>=W-2) { memXG_[i*W+j] = memX[i*W+j]; continue; }
+      for (int k=-2; k<=2; ++k)
+        for (int l=-2; l<=2; ++l)
+          write_reg(k+2, l+2, at(memX, i+k, j+l));
+      op_strobe();
+      memXG_[i*W+j] = read_reg(0);
+    }
+
+  // SOBEL 3x3
+  m_->OPMode = 1;
+  for (int i=0; i<H; ++i)
+    for (int j=0; j<W; ++j) {
+      for (int k=-1; k<=1; ++k)
+        for (int l=-1; l<=1; ++l)
+          write_reg(k+1, l+1, at(memXG_, i+k, j+l));
+      Gxy_[i*W+j]   = read_reg(1);
+      Theta_[i*W+j] = read_reg(2);
+    }
+
+  // NMS 3x3
+  m_->OPMode = 2;
+  for (int i=0; i<H; ++i)
+    for (int j=0; j<W; ++j) {
+      for (int k=-1; k<=1; ++k)
+        for (int l=-1; l<=1; ++l)
+          write_reg(k+1, l+1, at(Gxy_, i+k, j+l));
+      m_->dWriteReg = 1;
+      for (int k=-1; k<=1; ++k)
+        for (int l=-1; l<=1; ++l)
+          write_reg(k+1, l+1, at(Theta_, i+k, j+l));
+      m_->dWriteReg = 0;
+      nms_[i*W+j] = read_reg(3);
+    }
+
+  // HYSTERESIS 3x3, raster order: above/left neighbours are already final
+  m_->OPMode = 3;
+  for (int i=0; i<H; ++i)
+    for (int j=0; j<W; ++j) {
+      for (int k=-1; k<=1; ++k)
+        for (int l=-1; l<=1; ++l)
+          write_reg(k+1, l+1, (k<0 || (k==0 && l<0)) ? at(out, i+k, j+l) : at(nms_, i+k, j+l));
+      op_strobe();
+      out[i*W+j] = read_reg(4);
+    }
+}
+
+// ---- Stage functions ----
+void ff_adc_quantize(const std::vector<uint8_t>& image, const IdentityLUT& lut,
+                     std::vector<uint8_t>& out) {
+  out.resize(image.size());
+  for (size_t n = 0; n < image.size(); ++n) {
+    const double vin = static_cast<double>(image[n]);   // cmos_sensor sample
+    out[n] = lut.apply(clamp_u8((int)std::lround(vin)));
+  }
+}
+
+void ff_post_lut(const std::vector<uint8_t>& in, const Lut1DTable& lut,
+                 std::vector<uint8_t>& out, LutHistStats* stats) {
+  out.resize(in.size());
+  for (size_t n = 0; n < in.size(); ++n) {
+    const uint8_t y = lut[in[n]];
+    out[n] = y;
+    if (stats) stats->count(in[n], y);
+  }
+}
+
+void ff_pack_bursts(const std::vector<uint8_t>& bytes, std::vector<uint8_t>& beats) {
+  beats.assign((bytes.size() + 31) / 32 * 32, 0);
+  std::copy(bytes.begin(), bytes.end(), beats.begin());
+}
+
+void ff_build_post_lut(const FfOptions& opt, Lut1DTable& lut) {
+  lut.load_identity();
+  if (!opt.lut_path.empty()) {
+    if (!lut.load_lut_file(opt.lut_path))
+      std::cerr << "[LUT] Failed to load '" << opt.lut_path << "'. Using identity.\n";
+  } else {
+    if (opt.gain != 1.0 || opt.offs != 0.0) lut.apply_gain_offset(opt.gain, opt.offs);
+    if (opt.gamma > 0.0)                    lut.apply_gamma(opt.gamma);
+  }
+}
+
+// ---- Pipeline ----
+FastForwardPipeline::FastForwardPipeline(const FfOptions& opt, const Lut1DTable& post_lut)
+: opt_(opt), post_lut_(post_lut) {
+  if (!opt_.bypass_isp) isp_.reset(new CannyRtlModel(opt_.rtl_fast));
+}
+
+FastForwardPipeline::~FastForwardPipeline() = default;
+
+bool FastForwardPipeline::run_frame(const std::vector<uint8_t>& image, int W, int H,
+                                    FfFrameResult& r) {
+  const uint32_t N = (uint32_t)(W * H);
+  std::vector<uint8_t> adc, isp, lut;
+
+  ff_adc_quantize(image, adc_lut_, adc);
+  adc.resize(N, 0);   // sensor drives 0.0 past the end of the image
+  if (isp_) isp_->run(adc, W, H, isp);
+  else      isp.swap(adc);
+
+  r.stats = LutHistStats();
+  r.stats.enable(true);
+  ff_post_lut(isp, post_lut_, lut, &r.stats);
+
+  // compressor -> packer -> LPDDR (capacity-limited, wlast commits the size)
+  std::vector<uint8_t> stream, beats;
+  if (opt_.codec != CODEC_OFF) frame_encode(opt_.codec, lut, stream);
+  else                         stream.swap(lut);
+  ff_pack_bursts(stream, beats);
+  r.beats = (uint32_t)(beats.size() / 32);
+
+  const uint32_t cap = codec_max_bytes(opt_.codec, N);
+  if (beats.size() > cap) beats.resize(cap);
+  r.dram_bytes = (uint32_t)beats.size();
+
+  // host read-back
+  if (opt_.codec != CODEC_OFF) {
+    if (!frame_decode(opt_.codec, beats, N, r.out)) return false;
+  } else {
+    r.out.swap(beats);
+  }
+  if (r.out.size() < N) return false;
+  r.out.resize(N);
+  return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "IdentityLUT.h"
+#include "Lut1DTable.h"
+#include "FrameCodec.h"
+
+// Kernel-free functional model of the single-camera pipeline:
+//   ADC quantize -> IdentityLUT -> Canny (Verilated RTL) -> Lut1D -> 256b pack -> LPDDR
+// Whole-frame loops, no sc_main and no SystemC scheduling. Produces the bytes
+// the SystemC run writes to out.pgm plus the Lut1D_DE per-frame histograms.
+// One instance owns one RTL model: use one instance per worker thread.
+
+struct FfOptions {
+  double gamma = 0.0;          // post-ISP LUT programming (same as the CLI)
+  double gain  = 1.0;
+  double offs  = 0.0;
+  std::string lut_path;
+  bool bypass_isp = false;
+  FrameCodecMode codec = CODEC_OFF;
+  bool rtl_fast = false;       // ISP_LIGHT/ISP_ULTRA register sequence (default: full handshake)
+};
+
+struct FfFrameResult {
+  std::vector<uint8_t> out;    // host read-back, W*H bytes (== out.pgm payload)
+  LutHistStats stats;          // LUT in/out histograms of this frame
+  uint32_t dram_bytes = 0;     // bytes committed to LPDDR (compressed size if enabled)
+  uint32_t beats      = 0;     // 256-bit write beats
+};
+
+class CannyRtlModel;
+
+class FastForwardPipeline {
+public:
+  FastForwardPipeline(const FfOptions& opt, const Lut1DTable& post_lut);
+  ~FastForwardPipeline();
+
+  const Lut1DTable& post_lut() const { return post_lut_; }
+
+  // Run one frame through every stage; false if the read-back came up short.
+  bool run_frame(const std::vector<uint8_t>& image, int W, int H, FfFrameResult& r);
+
+private:
+  FfOptions   opt_;
+  IdentityLUT adc_lut_;        // CannyEdgeWrapper table (identity in the single-camera top)
+  Lut1DTable  post_lut_;       // Lut1D_DE table
+  std::unique_ptr<CannyRtlModel> isp_;
+};
+
+// Program the post-ISP table from the LUT options (warns and keeps identity
+// if the LUT file cannot be loaded).
+void ff_build_post_lut(const FfOptions& opt, Lut1DTable& lut);
+
+// Stage functions (whole-frame)
+void ff_adc_quantize(const std::vector<uint8_t>& image, const IdentityLUT& lut,
+                     std::vector<uint8_t>& out);
+void ff_post_lut(const std::vector<uint8_t>& in, const Lut1DTable& lut,
+                 std::vector<uint8_t>& out, LutHistStats* stats);
+// BurstPacker byte layout: lane k of beat b holds byte 32*b+k, the last beat
+// is zero-padded. Returns the beats concatenated (32 bytes each).
+void ff_pack_bursts(const std::vector<uint8_t>& bytes, std::vector<uint8_t>& beats);
@@ -0,0 +1,119 @@
+#include "FrameCodec.h"
+
+bool parse_codec_mode(const std::string& s, FrameCodecMode& mode) {
+  if (s == "off" || s == "none") { mode = CODEC_OFF;      return true; }
+  if (s == "bitplane" || s == "1bpp") { mode = CODEC_BITPLANE; return true; }
+  if (s == "rle")                { mode = CODEC_RLE;      return true; }
+  return false;
+}
+
+const char* codec_mode_name(FrameCodecMode mode) {
+  switch (mode) {
+    case CODEC_BITPLANE: return "bitplane";
+    case CODEC_RLE:      return "rle";
+    default:             return "off";
+  }
+}
+
+uint32_t codec_max_bytes(FrameCodecMode mode, uint32_t n) {
+  switch (mode) {
+    case CODEC_BITPLANE: return (n + 7) / 8;
+    case CODEC_RLE:      return n + (n + 127) / 128 + 1;
+    default:             return n;
+  }
+}
+
+// ---------------- Encoder ----------------
+void FrameEncoder::reset() {
+  bits_ = 0; nbits_ = 0; non_binary_ = 0;
+  lit_.clear(); run_val_ = 0; run_len_ = 0;
+}
+
+void FrameEncoder::flush_literals(std::vector<uint8_t>& out) {
+  if (lit_.empty()) return;
+  out.push_back((uint8_t)(lit_.size() - 1));
+  out.insert(out.end(), lit_.begin(), lit_.end());
+  lit_.clear();
+}
+
+void FrameEncoder::commit_run(std::vector<uint8_t>& out) {
+  if (run_len_ >= 3) {
+    flush_literals(out);
+    out.push_back((uint8_t)(128 + (run_len_ - 3)));
+    out.push_back(run_val_);
+  } else {
+    // short runs are cheaper as literals
+    for (unsigned i=0; i<run_len_; ++i) {
+      lit_.push_back(run_val_);
+      if (lit_.size() == 128) flush_literals(out);
+    }
+  }
+  run_len_ = 0;
+}
+
+void FrameEncoder::push(uint8_t pix, std::vector<uint8_t>& out) {
+  if (mode_ == CODEC_BITPLANE) {
+    if (pix != 0 && pix != 255) ++non_binary_;
+    if (pix >= 128) bits_ |= (uint8_t)(1u << nbits_);
+    if (++nbits_ == 8) { out.push_back(bits_); bits_ = 0; nbits_ = 0; }
+  } else if (mode_ == CODEC_RLE) {
+    if (run_len_ > 0 && pix == run_val_ && run_len_ < 130) { ++run_len_; return; }
+    commit_run(out);
+    run_val_ = pix;
+    run_len_ = 1;
+  } else {
+    out.push_back(pix);
+  }
+}
+
+void FrameEncoder::flush(std::vector<uint8_t>& out) {
+  if (mode_ == CODEC_BITPLANE) {
+    if (nbits_) { out.push_back(bits_); bits_ = 0; nbits_ = 0; }
+  } else if (mode_ == CODEC_RLE) {
+    commit_run(out);
+    flush_literals(out);
+  }
+}
+
+// ---------------- Decoder ----------------
+void FrameDecoder::reset() {
+  produced_ = 0; lit_left_ = 0; rep_cnt_ = 0;
+}
+
+void FrameDecoder::emit(uint8_t v, std::vector<uint8_t>& out) {
+  if (done()) return;
+  out.push_back(v);
+  ++produced_;
+}
+
+void FrameDecoder::push(uint8_t byte, std::vector<uint8_t>& out) {
+  if (done()) return;
+  if (mode_ == CODEC_BITPLANE) {
+    for (unsigned b=0; b<8; ++b) emit((byte >> b) & 1u ? 255 : 0, out);
+  } else if (mode_ == CODEC_RLE) {
+    if (lit_left_) { emit(byte, out); --lit_left_; return; }
+    if (rep_cnt_)  { for (unsigned i=0; i<rep_cnt_; ++i) emit(byte, out); rep_cnt_ = 0; return; }
+    if (byte < 128) lit_left_ = byte + 1u;
+    else            rep_cnt_  = (byte - 128u) + 3u;
+  } else {
+    emit(byte, out);
+  }
+}
+
+// ---------------- Whole-frame helpers ----------------
+void frame_encode(FrameCodecMode mode, const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+  out.clear();
+  out.reserve(codec_max_bytes(mode, (uint32_t)in.size()));
+  FrameEncoder enc(mode);
+  for (uint8_t p : in) enc.push(p, out);
+  enc.flush(out);
+}
+
+bool frame_decode(FrameCodecMode mode, const std::vector<uint8_t>& in, uint32_t n,
+                  std::vector<uint8_t>& out) {
+  out.clear();
+  out.reserve(n);
+  FrameDecoder dec(mode, n);
+  for (size_t i=0; i<in.size() && !dec.done(); ++i) dec.push(in[i], out);
+  return out.size() == n;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Lossless frame codecs shared by the DE compressor/decompressor and the host.
+// - CODEC_BITPLANE : 1 bit per pixel (bit = pix >= 128), LSB-first. Lossless for
+//                    binary edge maps (0/255 only); other values are counted.
+// - CODEC_RLE      : PackBits-style run-length. Header h < 128 -> h+1 literals
+//                    follow; h >= 128 -> next byte repeated (h-128)+3 times.
+//                    Worst case expansion is 129/128.
+enum FrameCodecMode { CODEC_OFF = 0, CODEC_BITPLANE = 1, CODEC_RLE = 2 };
+
+bool        parse_codec_mode(const std::string& s, FrameCodecMode& mode);
+const char* codec_mode_name(FrameCodecMode mode);
+
+// Upper bound of the encoded size of an n-pixel frame (capacity to reserve).
+uint32_t codec_max_bytes(FrameCodecMode mode, uint32_t n);
+
+// Streaming encoder: push one pixel at a time, flush at end of frame.
+// Encoded bytes are appended to 'out'.
+struct FrameEncoder {
+  explicit FrameEncoder(FrameCodecMode mode = CODEC_OFF) : mode_(mode) {}
+
+  void set_mode(FrameCodecMode mode) { mode_ = mode; reset(); }
+  void reset();
+
+  void push (uint8_t pix, std::vector<uint8_t>& out);
+  void flush(std::vector<uint8_t>& out);
+
+  // Pixels that bitplane mode could not represent exactly (not 0/255)
+  uint64_t non_binary() const { return non_binary_; }
+
+private:
+  FrameCodecMode mode_;
+
+  // Bitplane
+  uint8_t  bits_ = 0;
+  unsigned nbits_ = 0;
+  uint64_t non_binary_ = 0;
+
+  // RLE
+  std::vector<uint8_t> lit_;
+  uint8_t  run_val_ = 0;
+  unsigned run_len_ = 0;
+
+  void commit_run(std::vector<uint8_t>& out);
+  void flush_literals(std::vector<uint8_t>& out);
+};
+
+// Streaming decoder: push one encoded byte at a time, decoded pixels are appended
+// to 'out'. Stops producing pixels once 'limit' pixels were emitted for the frame.
+struct FrameDecoder {
+  explicit FrameDecoder(FrameCodecMode mode = CODEC_OFF, uint32_t limit = 0)
+  : mode_(mode), limit_(limit) {}
+
+  void set_mode(FrameCodecMode mode, uint32_t limit) { mode_ = mode; limit_ = limit; reset(); }
+  void reset();
+
+  void push(uint8_t byte, std::vector<uint8_t>& out);
+  bool done() const { return limit_ && produced_ >= limit_; }
+  uint32_t produced() const { return produced_; }
+
+private:
+  FrameCodecMode mode_;
+  uint32_t limit_;
+  uint32_t produced_ = 0;
+
+  // RLE state
+  unsigned lit_left_ = 0;   // literal bytes still to copy
+  unsigned rep_cnt_  = 0;   // >0 => next byte is the repeated value
+
+  void emit(uint8_t v, std::vector<uint8_t>& out);
+};
+
+// Whole-frame helpers (host side)
+void frame_encode(FrameCodecMode mode, const std::vector<uint8_t>& in, std::vector<uint8_t>& out);
+bool frame_decode(FrameCodecMode mode, const std::vector<uint8_t>& in, uint32_t n,
+                  std::vector<uint8_t>& out);
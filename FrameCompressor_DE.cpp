@@ -0,0 +1,77 @@
+#include "FrameCompressor_DE.h"
+#include <iostream>
+#include "Log.h"
+#include <algorithm>
+
+FrameCompressor_DE::FrameCompressor_DE(sc_core::sc_module_name name) : sc_module(name) {
+  SC_METHOD(step);
+  sensitive << clk.pos();
+}
+
+void FrameCompressor_DE::set_mode(FrameCodecMode mode) {
+  mode_ = mode;
+  enc_.set_mode(mode);
+  fifo_.clear();
+  frame_in_ = frame_out_ = 0;
+}
+
+void FrameCompressor_DE::end_frame() {
+  scratch_.clear();
+  enc_.flush(scratch_);
+  for (uint8_t b : scratch_) fifo_.emplace_back(b, false);
+  frame_out_ += scratch_.size();
+  if (!fifo_.empty()) fifo_.back().second = true;   // tag last byte of the frame
+
+  const double ratio = frame_out_ ? (double)frame_in_ / (double)frame_out_ : 0.0;
+  ISP_LOG(LOG_INFO, LOGC_CMP,
+          "frame " << frames_ << " mode=" << codec_mode_name(mode_)
+          << " raw=" << frame_in_ << " comp=" << frame_out_
+          << " ratio=" << ratio << "x"
+          << " saved=" << (frame_in_ > frame_out_ ? frame_in_ - frame_out_ : 0) << " B");
+  if (mode_ == CODEC_BITPLANE && enc_.non_binary())
+    ISP_LOG(LOG_WARN, LOGC_CMP, "WARNING non-binary=" << enc_.non_binary() << " (lossy)");
+
+  total_in_  += frame_in_;
+  total_out_ += frame_out_;
+  ++frames_;
+  frame_in_ = frame_out_ = 0;
+  enc_.reset();
+}
+
+void FrameCompressor_DE::step() {
+  if (mode_ == CODEC_OFF) return;
+
+  // Ingest
+  if (valid_in.read()) {
+    scratch_.clear();
+    enc_.push((uint8_t)pix_in.read().to_uint(), scratch_);
+    for (uint8_t b : scratch_) fifo_.emplace_back(b, false);
+    frame_out_ += scratch_.size();
+    ++frame_in_;
+  }
+  if (vsync_in.read() && frame_in_) end_frame();
+  fifo_peak_ = std::max(fifo_peak_, fifo_.size());
+
+  // Drain one byte per clock
+  if (!fifo_.empty()) {
+    pix_out.write(fifo_.front().first);
+    valid_out.write(true);
+    vsync_out.write(fifo_.front().second);
+    fifo_.pop_front();
+  } else {
+    valid_out.write(false);
+    vsync_out.write(false);
+  }
+}
+
+void FrameCompressor_DE::report() const {
+  if (mode_ == CODEC_OFF) return;
+  const double ratio = total_out_ ? (double)total_in_ / (double)total_out_ : 0.0;
+  std::cout << "[CMP] SUMMARY mode=" << codec_mode_name(mode_)
+            << " frames=" << frames_
+            << " raw=" << total_in_ << " comp=" << total_out_
+            << " ratio=" << ratio << "x"
+            << " dram_bytes_saved=" << (total_in_ > total_out_ ? total_in_ - total_out_ : 0)
+            << " bw_gain=" << ratio << "x"
+            << " fifo_peak=" << fifo_peak_ << "\n";
+}
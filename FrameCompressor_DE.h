@@ -0,0 +1,49 @@
+#pragma once
+#include <systemc>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include "FrameCodec.h"
+
+// Optional lossless compression stage between Lut1D_DE and BurstPacker.
+// Encodes the pixel stream (bitplane or RLE) and emits one compressed byte per
+// clock from an output FIFO; vsync_out marks the last byte of each frame so the
+// packer can flush the final partial beat.
+// In CODEC_OFF mode the module idles (top-level routes around it).
+struct FrameCompressor_DE : sc_core::sc_module {
+  sc_core::sc_in<bool>                clk;
+
+  sc_core::sc_in< sc_dt::sc_uint<8> > pix_in;
+  sc_core::sc_in<bool>                valid_in;
+  sc_core::sc_in<bool>                vsync_in;
+
+  sc_core::sc_out< sc_dt::sc_uint<8> > pix_out;
+  sc_core::sc_out<bool>                 valid_out;
+  sc_core::sc_out<bool>                 vsync_out;
+
+  SC_HAS_PROCESS(FrameCompressor_DE);
+  FrameCompressor_DE(sc_core::sc_module_name name);
+
+  void set_mode(FrameCodecMode mode);
+  FrameCodecMode mode() const { return mode_; }
+
+  void report() const;   // totals over all completed frames
+
+private:
+  FrameCodecMode mode_ = CODEC_OFF;
+  FrameEncoder   enc_;
+  std::vector<uint8_t> scratch_;
+
+  // Output FIFO: (byte, last-of-frame)
+  std::deque< std::pair<uint8_t,bool> > fifo_;
+  size_t fifo_peak_ = 0;
+
+  // Per-frame / total counters
+  uint64_t frame_in_  = 0, frame_out_ = 0;
+  uint64_t total_in_  = 0, total_out_ = 0;
+  uint64_t frames_    = 0;
+
+  void step();  // posedge clocked
+  void end_frame();
+};
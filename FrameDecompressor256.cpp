@@ -0,0 +1,40 @@
+#include "FrameDecompressor256.h"
+#include "Log.h"
+using sc_core::sc_time_stamp;
+
+FrameDecompressor256::FrameDecompressor256(sc_core::sc_module_name name) : sc_module(name) {
+  SC_CTHREAD(run, clk.pos());
+}
+
+void FrameDecompressor256::set_mode(FrameCodecMode mode, uint32_t frame_pixels) {
+  mode_ = mode; pixels_ = frame_pixels;
+  dec_.set_mode(mode, frame_pixels);
+  frame_.clear(); frame_.reserve(frame_pixels);
+  bytes_in_ = 0; started_ = false; printed_ = false;
+}
+
+void FrameDecompressor256::run() {
+  wait();
+  for (;;) {
+    if (mode_ != CODEC_OFF && valid_in.read() && !dec_.done()) {
+      if (!started_) { started_ = true; t0_ = sc_time_stamp(); }
+      const sc_dt::sc_bv<256> v = data_in.read();
+      for (int i=0; i<32 && !dec_.done(); ++i) {
+        dec_.push((uint8_t)v.range(8*i+7, 8*i).to_uint(), frame_);
+        ++bytes_in_;
+      }
+      if (!printed_ && dec_.done()) {
+        t1_ = sc_time_stamp();
+        double gbps = 0.0;
+        auto dt = t1_ - t0_;
+        if (dt.value() > 0) gbps = (double)pixels_ / (dt.to_seconds() * 1e9);
+        ISP_LOG(LOG_INFO, LOGC_DECOMP, "mode=" << codec_mode_name(mode_)
+                << " bytes_rd=" << bytes_in_ << " pixels=" << pixels_
+                << " effective=" << gbps << " GB/s"
+                << " gain=" << (bytes_in_ ? (double)pixels_ / (double)bytes_in_ : 0.0) << "x");
+        printed_ = true;
+      }
+    }
+    wait();
+  }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <systemc>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include "FrameCodec.h"
+
+// Passive decompressor on the 256-bit read stream (next to ReadSink256).
+// Decodes each beat back to pixels and reports the effective pixel bandwidth
+// against the compressed bytes actually read from DRAM.
+struct FrameDecompressor256 : sc_core::sc_module {
+  sc_core::sc_in<bool>                clk;
+  sc_core::sc_in< sc_dt::sc_bv<256> > data_in;
+  sc_core::sc_in<bool>                valid_in;
+
+  SC_HAS_PROCESS(FrameDecompressor256);
+  FrameDecompressor256(sc_core::sc_module_name name);
+
+  void set_mode(FrameCodecMode mode, uint32_t frame_pixels);
+  const std::vector<uint8_t>& frame() const { return frame_; }
+
+private:
+  FrameCodecMode mode_ = CODEC_OFF;
+  uint32_t       pixels_ = 0;
+  FrameDecoder   dec_;
+  std::vector<uint8_t> frame_;
+
+  uint64_t bytes_in_ = 0;
+  bool     started_  = false;
+  bool     printed_  = false;
+  sc_core::sc_time t0_, t1_;
+
+  void run();
+};
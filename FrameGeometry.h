@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+
+// Frame geometry as a template parameter for the per-pixel kernels.
+// FixedGeometry<W,H> makes the dimensions compile-time constants, so row
+// offsets, border tests and window loops fold; RuntimeGeometry carries them
+// as values for any other size. Both expose the same interface.
+template <int W, int H>
+struct FixedGeometry {
+  FixedGeometry(int, int) {}
+  static constexpr int w() { return W; }
+  static constexpr int h() { return H; }
+  static constexpr size_t idx(int i, int j) { return (size_t)i * W + j; }
+  // (i,j) has its full (2r+1)^2 window inside the frame
+  static constexpr bool row_inside(int i, int r) { return i >= r && i < H - r; }
+  static constexpr bool col_inside(int j, int r) { return j >= r && j < W - r; }
+  static constexpr bool fixed = true;
+};
+
+struct RuntimeGeometry {
+  RuntimeGeometry(int W, int H) : w_(W), h_(H) {}
+  int w() const { return w_; }
+  int h() const { return h_; }
+  size_t idx(int i, int j) const { return (size_t)i * w_ + j; }
+  bool row_inside(int i, int r) const { return i >= r && i < h_ - r; }
+  bool col_inside(int j, int r) const { return j >= r && j < w_ - r; }
+  static constexpr bool fixed = false;
+private:
+  int w_, h_;
+};
+
+// Calls f(geometry) with the specialization for W x H (production sensor
+// sizes), or RuntimeGeometry for anything else or when 'generic' is set.
+template <class F>
+void with_geometry(int W, int H, bool generic, F&& f) {
+  if (!generic) {
+    if (W ==  640 && H ==  480) { f(FixedGeometry< 640,  480>(W, H)); return; }
+    if (W == 1920 && H == 1080) { f(FixedGeometry<1920, 1080>(W, H)); return; }
+    if (W == 3840 && H == 2160) { f(FixedGeometry<3840, 2160>(W, H)); return; }
+  }
+  f(RuntimeGeometry(W, H));
+}
@@ -10,6 +10,8 @@ using sc_core::sc_time_stamp;
 #include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include "FrameGeometry.h"
+#include "Log.h"
 
 // ------ env helpers ------
 static inline bool env_on(const char* n){
@@ -24,30 +26,65 @@ static inline int env_int(const char* n, int dflt){
 // ------ runtime switches ------
 static const bool ISP_ULTRA   = env_on("ISP_ULTRA");   // even fewer waits than LIGHT
 static const bool ISP_LIGHT   = env_on("ISP_LIGHT");   // reduce pulses -> faster sim
-static const bool ISP_VERBOSE = env_on("ISP_VERBOSE"); // print stage progress
-static const bool ISP_QUIET   = env_on("ISP_QUIET");   // hide stage prints
-static const int  ISP_ROW_STEP= env_int("ISP_ROW_STEP", 8); // progress granularity
+static const int  ISP_ROW_STEP= env_int("ISP_ROW_STEP", 8); // progress granularity (debug log)
+static const int  ISP_SETTLE_ROWS = env_int("ISP_SETTLE_ROWS", 1); // fast modes: rows per aggregated wait (0 = legacy, no accounting)
+static const bool ISP_INCREMENTAL = env_on("ISP_INCREMENTAL");   // recompute only tiles that changed
+static const int  ISP_TILE        = env_int("ISP_TILE", 16);     // incremental tile edge (px)
+static const bool ISP_GENERIC_GEOM = env_on("ISP_GENERIC_GEOM"); // runtime geometry even for specialized sizes
+
+// Dependency halo of each stage output on the input frame (px)
+static const int HALO[4] = { 2, 3, 4, 5 };  // GAUSS 5x5, then +1 per 3x3 stage
+
+// Full-handshake cost of each register-driver primitive (clock cycles; one tick = 2)
+static const unsigned CYC_PULSE_CE  = 6;  // 3 ticks
+static const unsigned CYC_READ_REG  = 6;  // 3 ticks
+static const unsigned CYC_OP_STROBE = 4;  // 2 ticks
 
 ISP_Canny::ISP_Canny(sc_core::sc_module_name name, int width, int height)
 : sc_module(name), W_(width), H_(height), N_(width*height)
 {
-  SC_CTHREAD(run, clk.pos());
-  memX_.resize(N_);  memXG_.resize(N_);
+  SC_CTHREAD(ingest, clk.pos());
+  SC_CTHREAD(compute, clk.pos());
+  SC_CTHREAD(stream_out, clk.pos());
+  memX_[0].resize(N_); memX_[1].resize(N_);
+  out_[0].resize(N_);  out_[1].resize(N_);
+  memXG_.resize(N_);
   Gxy_.resize(N_);   Theta_.resize(N_);
-  bGxy_.resize(N_);
+  nms_.resize(N_);   bGxy_.resize(N_);
+  for (auto& m : mask_) m.assign(N_, 1);
   m_ = new VCannyEdge;
+  with_geometry(W_, H_, ISP_GENERIC_GEOM, [this](auto g) {
+    passes_     = &ISP_Canny::passes<decltype(g)>;
+    fixed_geom_ = decltype(g)::fixed;
+  });
 }
 
 ISP_Canny::~ISP_Canny() { delete m_; m_ = nullptr; }
 
-// Advance Verilated clock; in ULTRA we don’t consume simulation time
+void ISP_Canny::yield() {
+  wait();
+  ++waited_cycles_;
+}
+
+void ISP_Canny::settle() {
+  if (ISP_SETTLE_ROWS <= 0) return;
+  if (rtl_cycles_ > waited_cycles_) {
+    const uint64_t debt = rtl_cycles_ - waited_cycles_;
+    wait(static_cast<int>(debt));
+    waited_cycles_ += debt;
+  }
+}
+
+// Advance Verilated clock; in ULTRA we don’t consume simulation time here
+// (the cycles are accounted and paid off in settle())
 void ISP_Canny::tick() {
+  rtl_cycles_ += 2;
   if (ISP_ULTRA) {
     m_->clk = 1; m_->eval();
     m_->clk = 0; m_->eval();
   } else {
-    m_->clk = 1; m_->eval(); wait();
-    m_->clk = 0; m_->eval(); wait();
+    m_->clk = 1; m_->eval(); yield();
+    m_->clk = 0; m_->eval(); yield();
   }
 }
 
@@ -61,6 +98,7 @@ void ISP_Canny::pulse_ce() {
   if (ISP_ULTRA || ISP_LIGHT) {
     m_->bCE = 1; m_->eval();
     m_->bCE = 0; m_->eval();
+    rtl_cycles_ += CYC_PULSE_CE;
   } else {
     m_->bCE = 1; m_->eval(); tick();
     m_->bCE = 0; m_->eval(); tick();
@@ -82,10 +120,12 @@ uint8_t ISP_Canny::read_reg(int which) {
   if (ISP_ULTRA) {
     m_->bCE = 1; m_->eval();
     m_->bCE = 0; m_->eval();
+    rtl_cycles_ += CYC_READ_REG;
     return (uint8_t)m_->OutData;
   } else if (ISP_LIGHT) {
-    m_->bCE = 1; m_->eval(); wait();
+    m_->bCE = 1; m_->eval(); yield();
     m_->bCE = 0; m_->eval();
+    rtl_cycles_ += CYC_READ_REG;
     return (uint8_t)m_->OutData;
   } else {
     m_->bCE = 1; m_->eval(); tick();
@@ -96,146 +136,405 @@ uint8_t ISP_Canny::read_reg(int which) {
   }
 }
 
-void ISP_Canny::run() {
-  // flush logs immediately
-  std::cout.setf(std::ios::unitbuf);
-
-  // default outputs
-  pix_out.write(0);
-  valid_out.write(false);
-  vsync_out.write(false);
+void ISP_Canny::op_strobe() {
+  m_->bOPEnable = 0; m_->eval();
+  if (!ISP_ULTRA) { if (ISP_LIGHT) yield(); else tick(); }
+  m_->bOPEnable = 1; m_->eval();
+  if (!ISP_ULTRA) { if (ISP_LIGHT) yield(); else tick(); }
+  if (ISP_ULTRA || ISP_LIGHT) rtl_cycles_ += CYC_OP_STROBE;
+}
 
-  reset_rtl();
+// Ingest thread: capture frames into the free input buffer. With both input
+// buffers busy at its first pixel the incoming frame is consumed and counted
+// as dropped, or, with ready_out bound, the source is held off until a
+// buffer frees up.
+void ISP_Canny::ingest() {
+  const unsigned IDLE_LIMIT = (unsigned)env_int("ISP_IDLE_LIMIT", 200000);
+  const bool elastic = ready_out.size() > 0;
+  if (elastic) ready_out->write(true);
+  wait();
 
   while (true) {
+    const int b = in_wr_;
+    if (elastic) {
+      // hold the source off until compute frees this buffer
+      if (in_full_[b]) { ready_out->write(false); while (in_full_[b]) wait(); }
+      ready_out->write(true);   // seen from the next edge on
+    }
+    // drop or keep is decided at the first pixel: compute may free the
+    // buffer during the gap between frames
+    bool drop = false;
+    std::vector<uint8_t>* dst = nullptr;
+
     // -------- Ingest one frame from upstream --------
     int n = 0;
     bool saw_vsync = false;
     unsigned idle = 0;
-    const unsigned IDLE_LIMIT = (unsigned)env_int("ISP_IDLE_LIMIT", 200000);
+    sc_core::sc_time t_first;
 
-    while (n < N_) {
-      if (valid_in.read()) { memX_[n++] = (uint8_t)pix_in.read().to_uint(); idle = 0; }
+    bool ended = false;
+    while (n < N_ && !ended) {
+      if (valid_in.read() && (!elastic || ready_out->read())) {
+        if (n == 0) {
+          t_first = sc_core::sc_time_stamp();
+          drop = in_full_[b];
+          dst  = drop ? nullptr : &memX_[b];
+        }
+        if (dst) (*dst)[n] = (uint8_t)pix_in.read().to_uint();
+        ++n; idle = 0;
+        if (elastic) {
+          ended = vsync_in.read();   // a cut frame ends early
+          // the next pixel goes to the other buffer (a cut frame frees
+          // this one): refuse it while busy
+          if (ended || n == N_) ready_out->write(!in_full_[n < N_ ? b : b ^ 1]);
+        }
+      }
       if (vsync_in.read()) saw_vsync = true;
 
-      if (++idle > IDLE_LIMIT) {
-        if (ISP_VERBOSE && !ISP_QUIET)
-          std::cout << "[ISP] ingest timeout n=" << n << "/" << N_
-                    << " vsync=" << (saw_vsync?1:0) << "\n";
+      // only time out once a frame has started (ingest idles between frames)
+      if (n > 0 && ++idle > IDLE_LIMIT) {
+        ISP_LOG(LOG_DEBUG, LOGC_ISP, "ingest timeout n=" << n << "/" << N_
+                                     << " vsync=" << (saw_vsync?1:0));
         break;
       }
       wait();
     }
+
+    if (drop) {
+      ++frames_dropped_;
+      ISP_LOG(LOG_DEBUG, LOGC_ISP, "both input buffers busy, dropped frame (" << frames_dropped_ << ")");
+      continue;
+    }
+    if (ended && n < N_) {
+      // cut by the elastic source (drop=frame): discard, never pad
+      ++frames_dropped_;
+      ISP_LOG(LOG_DEBUG, LOGC_ISP, "cut frame " << n << "/" << N_ << " discarded (" << frames_dropped_ << ")");
+      continue;
+    }
     if (n < N_) {
-      std::fill(memX_.begin() + n, memX_.begin() + N_, 0);
-      if (!ISP_QUIET)
-        std::cout << "[ISP] WARNING: short frame " << n << "/" << N_
-                  << " (vsync=" << (saw_vsync?1:0) << "), padded remainder\n";
-    } else if (!ISP_QUIET) {
-      std::cout << "[ISP] Ingested " << N_ << " pixels\n";
+      std::fill(dst->begin() + n, dst->begin() + N_, 0);
+      ISP_LOG(LOG_WARN, LOGC_ISP, "WARNING: short frame " << n << "/" << N_
+                                  << " (vsync=" << (saw_vsync?1:0) << "), padded remainder");
+    } else {
+      ISP_LOG(LOG_INFO, LOGC_ISP, "Ingested " << N_ << " pixels (buf " << b << ")");
     }
+    in_t0_[b]   = t_first;
+    in_full_[b] = true;
+    in_wr_      = b ^ 1;
+  }
+}
+
+// Compute thread: four RTL passes on the oldest full input buffer; the input
+// buffer is released after the Gaussian pass, the result is handed to the
+// free output buffer.
+void ISP_Canny::compute() {
+  reset_rtl();
+
+  while (true) {
+    const int b = in_rd_;
+    while (!in_full_[b]) wait();
+    const sc_core::sc_time t_in = in_t0_[b];
+    const sc_core::sc_time t_c0 = sc_core::sc_time_stamp();
+    if (ISP_INCREMENTAL) plan_incremental(memX_[b]);
+    const uint64_t frame_rtl0 = rtl_cycles_;
+
+    (this->*passes_)(b);
+    if (keep_snap_) { settled_ = SnapBuf(); pack_state(settled_, have_prev_); }
+
+    // -------- Hand the result to stream-out --------
+    const int o = out_wr_;
+    while (out_full_[o]) wait();
+    std::copy(bGxy_.begin(), bGxy_.end(), out_[o].begin());
+    out_t0_[o]   = t_in;
+    out_busy_[o] = sc_core::sc_time_stamp() - t_c0;
+    out_cyc_[o]  = rtl_cycles_ - frame_rtl0;
+    out_full_[o] = true;
+    out_wr_      = o ^ 1;
 
-    // Common defaults
-    m_->bOPEnable = 1;
-    m_->dWriteReg = 0;
-    m_->OPMode    = 0;
+    ISP_LOG(LOG_INFO, LOGC_ISP, "Compute complete (rtl_cycles=" << (rtl_cycles_ - frame_rtl0)
+                                << ", t=" << sc_core::sc_time_stamp() << ")");
+  }
+}
 
-    const int row_step = (ISP_ROW_STEP > 0 ? ISP_ROW_STEP : 8);
+// Sends the (2R+1)^2 window around (i,j) to the RTL register file, row by
+// row. Inside the frame it walks row pointers; on the border it falls back
+// to the zero-padded at().
+template <int R, class G>
+inline void ISP_Canny::send_window(const G& g, const std::vector<uint8_t>& v, int i, int j, bool row_in) {
+  if (row_in && g.col_inside(j, R)) {
+    const uint8_t* p = v.data() + g.idx(i - R, j - R);
+    for (int k=0; k<=2*R; ++k, p += g.w())
+      for (int l=0; l<=2*R; ++l)
+        write_reg(k, l, p[l]);
+  } else {
+    for (int k=-R; k<=R; ++k)
+      for (int l=-R; l<=R; ++l)
+        write_reg(k+R, l+R, at(v, i+k, j+l));
+  }
+}
 
-    // ====== GAUSSIAN 5x5 (memX -> memXG) ======
-    m_->OPMode    = 0;           // MODE_GAUSSIAN
-    m_->dWriteReg = 0;           // WRITE_REGX
-    for (int i=0; i<H_; ++i) {
-      for (int j=0; j<W_; ++j) {
-        if (i<2 || j<2 || i>=H_-2 || j>=W_-2) { memXG_[i*W_+j] = memX_[i*W_+j]; continue; }
-        for (int k=-2; k<=2; ++k)
-          for (int l=-2; l<=2; ++l)
-            write_reg(k+2, l+2, at(memX_, i+k, j+l));
+// The four RTL passes for one frame in input buffer b, with the geometry
+// as G (FrameGeometry.h): compile-time for the specialized sensor sizes.
+template <class G>
+void ISP_Canny::passes(int b) {
+  const G g(W_, H_);
+  const int Wd = g.w(), Hd = g.h();
+  const std::vector<uint8_t>& memX = memX_[b];
+  const bool inc = ISP_INCREMENTAL;
+  uint64_t work[4] = {0, 0, 0, 0};   // pixels sent through the RTL per stage
+
+  // Common defaults
+  m_->bOPEnable = 1;
+  m_->dWriteReg = 0;
+  m_->OPMode    = 0;
+
+  const int row_step = (ISP_ROW_STEP > 0 ? ISP_ROW_STEP : 8);
+  const int settle_rows = ISP_SETTLE_ROWS;
+  uint64_t stage_rtl0 = rtl_cycles_;
+  auto stage_cycles = [&](){ const uint64_t d = rtl_cycles_ - stage_rtl0; stage_rtl0 = rtl_cycles_; return d; };
+  auto end_row = [&](int i, const char* stage) {
+    if (i%row_step==0) ISP_LOG(LOG_DEBUG, LOGC_ISP, stage << " row " << i << "/" << Hd);
+    if (settle_rows > 0) { if ((i+1) % settle_rows == 0 || i == Hd-1) settle(); }
+    else if (ISP_ULTRA && (i % 1024 == 0)) wait();
+  };
+
+  // ====== GAUSSIAN 5x5 (memX -> memXG) ======
+  // The 2-pixel frame border is copied through; the interior never clips.
+  m_->OPMode    = 0;           // MODE_GAUSSIAN
+  m_->dWriteReg = 0;           // WRITE_REGX
+  for (int i=0; i<Hd; ++i) {
+    const size_t row = g.idx(i, 0);
+    if (!g.row_inside(i, 2)) {
+      std::copy(memX.begin() + row, memX.begin() + row + Wd, memXG_.begin() + row);
+    } else {
+      for (int j=0; j<Wd; ++j) {
+        if (!g.col_inside(j, 2)) { memXG_[row + j] = memX[row + j]; continue; }
+        if (inc && !mask_[0][row + j]) continue;   // clean: keep cached memXG_
+        ++work[0];
+        send_window<2>(g, memX, i, j, true);
 
         // latch/compute then read REG_GAUSSIAN (=0)
-        m_->bOPEnable = 0; m_->eval();
-        if (!ISP_ULTRA) { if (ISP_LIGHT) wait(); else tick(); }
-        m_->bOPEnable = 1; m_->eval();
-        if (!ISP_ULTRA) { if (ISP_LIGHT) wait(); else tick(); }
+        op_strobe();
 
-        memXG_[i*W_+j] = read_reg(0);
+        memXG_[row + j] = read_reg(0);
       }
-      if (ISP_VERBOSE && !ISP_QUIET && (i%row_step==0))
-        std::cout << "[ISP] GAUSS row " << i << "/" << H_ << "\n";
-      if (ISP_ULTRA && (i % 1024 == 0)) wait();
     }
-    if (!ISP_QUIET) std::cout << "[ISP] GAUSS done\n";
+    end_row(i, "GAUSS");
+  }
+  ISP_LOG(LOG_INFO, LOGC_ISP, "GAUSS done (rtl_cycles=" << stage_cycles() << ")");
 
-    // ====== SOBEL 3x3 (memXG -> Gxy, Theta) ======
-    m_->OPMode    = 1;           // MODE_SOBEL
-    m_->dWriteReg = 0;           // WRITE_REGX
-    for (int i=0; i<H_; ++i) {
-      for (int j=0; j<W_; ++j) {
-        for (int k=-1; k<=1; ++k)
-          for (int l=-1; l<=1; ++l)
-            write_reg(k+1, l+1, at(memXG_, i+k, j+l));
-        Gxy_[i*W_+j]   = read_reg(1); // REG_GRADIENT
-        Theta_[i*W_+j] = read_reg(2); // REG_DIRECTION
-      }
-      if (ISP_VERBOSE && !ISP_QUIET && (i%row_step==0))
-        std::cout << "[ISP] SOBEL row " << i << "/" << H_ << "\n";
-      if (ISP_ULTRA && (i % 1024 == 0)) wait();
+  // memX is no longer needed: let ingest refill this buffer
+  in_full_[b] = false;
+  in_rd_      = b ^ 1;
+
+  // ====== SOBEL 3x3 (memXG -> Gxy, Theta) ======
+  m_->OPMode    = 1;           // MODE_SOBEL
+  m_->dWriteReg = 0;           // WRITE_REGX
+  for (int i=0; i<Hd; ++i) {
+    const size_t row = g.idx(i, 0);
+    const bool row_in = g.row_inside(i, 1);
+    for (int j=0; j<Wd; ++j) {
+      if (inc && !mask_[1][row + j]) continue;   // clean: keep cached Gxy_/Theta_
+      ++work[1];
+      send_window<1>(g, memXG_, i, j, row_in);
+      Gxy_[row + j]   = read_reg(1); // REG_GRADIENT
+      Theta_[row + j] = read_reg(2); // REG_DIRECTION
     }
-    if (!ISP_QUIET) std::cout << "[ISP] SOBEL done\n";
+    end_row(i, "SOBEL");
+  }
+  ISP_LOG(LOG_INFO, LOGC_ISP, "SOBEL done (rtl_cycles=" << stage_cycles() << ")");
 
-    // ====== NMS 3x3 (Gxy + Theta -> bGxy) ======
-    m_->OPMode    = 2;  // MODE_NMS
-    m_->dWriteReg = 0;  // WRITE_REGX first
-    for (int i=0; i<H_; ++i) {
-      for (int j=0; j<W_; ++j) {
+  // ====== NMS 3x3 (Gxy + Theta -> bGxy) ======
+  m_->OPMode    = 2;  // MODE_NMS
+  m_->dWriteReg = 0;  // WRITE_REGX first
+  for (int i=0; i<Hd; ++i) {
+    const size_t row = g.idx(i, 0);
+    const bool row_in = g.row_inside(i, 1);
+    for (int j=0; j<Wd; ++j) {
+      if (inc && !mask_[2][row + j]) continue;   // clean: keep cached nms_
+      ++work[2];
+      send_window<1>(g, Gxy_, i, j, row_in);
+      m_->dWriteReg = 1; // WRITE_REGY
+      send_window<1>(g, Theta_, i, j, row_in);
+      m_->dWriteReg = 0;
+      nms_[row + j] = read_reg(3); // REG_NMS
+    }
+    end_row(i, "NMS");
+  }
+  ISP_LOG(LOG_INFO, LOGC_ISP, "NMS done (rtl_cycles=" << stage_cycles() << ")");
+
+  // ====== HYSTERESIS 3x3 (nms -> bGxy final) ======
+  // Raster order, in-place semantics: neighbours above and to the left are
+  // read from the final buffer, the rest from the NMS result.
+  m_->OPMode    = 3;  // MODE_HYSTERESIS
+  m_->dWriteReg = 0;  // WRITE_REGX
+  for (int i=0; i<Hd; ++i) {
+    const size_t row = g.idx(i, 0);
+    const bool row_in = g.row_inside(i, 1);
+    for (int j=0; j<Wd; ++j) {
+      if (inc && !mask_[3][row + j]) continue;   // clean: keep cached bGxy_
+      ++work[3];
+      if (row_in && g.col_inside(j, 1)) {
+        const uint8_t* up  = bGxy_.data() + row - Wd + j;
+        const uint8_t* mid = nms_.data()  + row + j;
+        for (int l=-1; l<=1; ++l) write_reg(0, l+1, up[l]);
+        write_reg(1, 0, bGxy_[row + j - 1]);
+        write_reg(1, 1, mid[0]);
+        write_reg(1, 2, mid[1]);
+        for (int l=-1; l<=1; ++l) write_reg(2, l+1, mid[Wd + l]);
+      } else {
         for (int k=-1; k<=1; ++k)
           for (int l=-1; l<=1; ++l)
-            write_reg(k+1, l+1, at(Gxy_, i+k, j+l));
-        m_->dWriteReg = 1; // WRITE_REGY
-        for (int k=-1; k<=1; ++k)
+            write_reg(k+1, l+1, (k<0 || (k==0 && l<0)) ? at(bGxy_, i+k, j+l) : at(nms_, i+k, j+l));
+      }
+      op_strobe();
+      const uint8_t v = read_reg(4); // REG_HYSTERESIS
+      if (inc && v != bGxy_[row + j]) {
+        // a changed final value feeds the pixels that read it later
+        if (j+1 < Wd) mask_[3][row + j+1] = 1;
+        if (i+1 < Hd)
           for (int l=-1; l<=1; ++l)
-            write_reg(k+1, l+1, at(Theta_, i+k, j+l));
-        m_->dWriteReg = 0;
-        bGxy_[i*W_+j] = read_reg(3); // REG_NMS
+            if (j+l >= 0 && j+l < Wd) mask_[3][row + Wd + j+l] = 1;
       }
-      if (ISP_VERBOSE && !ISP_QUIET && (i%row_step==0))
-        std::cout << "[ISP] NMS row " << i << "/" << H_ << "\n";
-     if (ISP_ULTRA && (i % 1024 == 0)) wait();
+      bGxy_[row + j] = v;
     }
-    if (!ISP_QUIET) std::cout << "[ISP] NMS done\n";
+    end_row(i, "HYSTERESIS");
+  }
+  ISP_LOG(LOG_INFO, LOGC_ISP, "HYSTERESIS done (rtl_cycles=" << stage_cycles() << ")");
+  if (inc)
+    ISP_LOG(LOG_INFO, LOGC_ISP, "incremental tiles reused=" << (tiles_total_ - tiles_dirty_) << "/" << tiles_total_
+                                << " recomputed px GAUSS=" << work[0] << " SOBEL=" << work[1]
+                                << " NMS=" << work[2] << " HYST=" << work[3] << " of " << N_);
+}
 
-    // ====== HYSTERESIS 3x3 (bGxy -> final) ======
-    m_->OPMode    = 3;  // MODE_HYSTERESIS
-    m_->dWriteReg = 0;  // WRITE_REGX
-    for (int i=0; i<H_; ++i) {
-      for (int j=0; j<W_; ++j) {
-        for (int k=-1; k<=1; ++k)
-          for (int l=-1; l<=1; ++l)
-            write_reg(k+1, l+1, at(bGxy_, i+k, j+l));
-        m_->bOPEnable = 0; m_->eval();
-        if (!ISP_ULTRA) { if (ISP_LIGHT) wait(); else tick(); }
-        m_->bOPEnable = 1; m_->eval();
-        if (!ISP_ULTRA) { if (ISP_LIGHT) wait(); else tick(); }
-        bGxy_[i*W_+j] = read_reg(4); // REG_HYSTERESIS
+// Incremental mode: diff each input tile against the previous frame and mark,
+// per stage, every output pixel whose window can reach a changed tile
+// (tile grown by the stage's cumulative halo). First frame is fully dirty.
+void ISP_Canny::plan_incremental(const std::vector<uint8_t>& in) {
+  const int T  = ISP_TILE > 0 ? ISP_TILE : 16;
+  const int tx = (W_ + T - 1) / T;
+  const int ty = (H_ + T - 1) / T;
+  tiles_total_ = (uint64_t)tx * ty;
+
+  if (!have_prev_) {
+    for (auto& m : mask_) std::fill(m.begin(), m.end(), 1);
+    tiles_dirty_ = tiles_total_;
+  } else {
+    for (auto& m : mask_) std::fill(m.begin(), m.end(), 0);
+    tiles_dirty_ = 0;
+    for (int ti=0; ti<ty; ++ti) {
+      for (int tj=0; tj<tx; ++tj) {
+        const int i0 = ti*T, i1 = std::min(H_, i0 + T);
+        const int j0 = tj*T, j1 = std::min(W_, j0 + T);
+        bool changed = false;
+        for (int i=i0; i<i1 && !changed; ++i)
+          changed = !std::equal(in.begin() + i*W_ + j0, in.begin() + i*W_ + j1,
+                                prev_in_.begin() + i*W_ + j0);
+        if (!changed) continue;
+        ++tiles_dirty_;
+        for (int s=0; s<4; ++s) {
+          const int h = HALO[s];
+          const int a0 = std::max(0, i0 - h), a1 = std::min(H_, i1 + h);
+          const int b0 = std::max(0, j0 - h), b1 = std::min(W_, j1 + h);
+          for (int i=a0; i<a1; ++i)
+            std::fill(mask_[s].begin() + i*W_ + b0, mask_[s].begin() + i*W_ + b1, 1);
+        }
       }
-      if (ISP_VERBOSE && !ISP_QUIET && (i%row_step==0))
-        std::cout << "[ISP] HYSTERESIS row " << i << "/" << H_ << "\n";
-      if (ISP_ULTRA && (i % 1024 == 0)) wait();
     }
-    if (!ISP_QUIET) std::cout << "[ISP] HYSTERESIS done\n";
+  }
+  prev_in_.assign(in.begin(), in.end());
+  have_prev_ = true;
+}
+
+void ISP_Canny::save_state(SnapBuf& s) const {
+  // no finished frame: the buffers may be half written, so restore must
+  // not trust them as a cache
+  if (settled_.b.empty()) pack_state(s, false);
+  else                    s.raw(settled_.b.data(), settled_.b.size());
+}
+
+void ISP_Canny::pack_state(SnapBuf& s, bool have_prev) const {
+  s.u32((uint32_t)W_);
+  s.u32((uint32_t)H_);
+  s.u8(have_prev ? 1 : 0);
+  s.bytes(prev_in_);
+  s.bytes(memXG_); s.bytes(Gxy_); s.bytes(Theta_); s.bytes(nms_); s.bytes(bGxy_);
+}
+
+bool ISP_Canny::restore_state(SnapCursor& c) {
+  if (c.u32() != (uint32_t)W_ || c.u32() != (uint32_t)H_) return false;
+  const bool have_prev = c.u8() != 0;
+  std::vector<uint8_t> prev, xg, gxy, th, nms, fin;
+  c.bytes(prev); c.bytes(xg); c.bytes(gxy); c.bytes(th); c.bytes(nms); c.bytes(fin);
+  if (!c.ok()) return false;
+  for (const auto* v : { &xg, &gxy, &th, &nms, &fin })
+    if (v->size() != (size_t)N_) return false;
+
+  have_prev_ = have_prev && prev.size() == (size_t)N_;
+  prev_in_.swap(prev);
+  memXG_.swap(xg); Gxy_.swap(gxy); Theta_.swap(th); nms_.swap(nms); bGxy_.swap(fin);
+  if (keep_snap_) { settled_ = SnapBuf(); pack_state(settled_, have_prev_); }
+  return true;
+}
+
+// Stream-out thread: one pixel per clock from the oldest full output buffer.
+void ISP_Canny::stream_out() {
+  // default outputs
+  pix_out.write(0);
+  valid_out.write(false);
+  vsync_out.write(false);
+  wait();
+
+  while (true) {
+    const int o = out_rd_;
+    while (!out_full_[o]) wait();
 
     // -------- Stream out the processed frame --------
+    const std::vector<uint8_t>& res = out_[o];
     for (int n2=0; n2<N_; ++n2) {
-      pix_out.write(bGxy_[n2]);
+      pix_out.write(res[n2]);
       valid_out.write(true);
       vsync_out.write(n2 == N_ - 1); // pulse vsync on last pixel
       wait();
     }
     valid_out.write(false);
     vsync_out.write(false);
+    out_full_[o] = false;
+    out_rd_      = o ^ 1;
+
+    // Latency: first pixel in -> last pixel out; throughput: frame-to-frame interval
+    const sc_core::sc_time t_done = sc_core::sc_time_stamp();
+    const sc_core::sc_time lat    = t_done - out_t0_[o];
+    lat_sum_ += lat;
+    if (lat > lat_max_) lat_max_ = lat;
+    if (perf_) {
+      const double interval_ns = frames_out_ ? (t_done - t_last_done_).to_seconds() * 1e9 : 0.0;
+      perf_->record("isp", frames_out_ + 1, out_busy_[o],
+                    { {"latency_ns", lat.to_seconds() * 1e9},
+                      {"compute_ns", out_busy_[o].to_seconds() * 1e9},
+                      {"rtl_cycles", (double)out_cyc_[o]},
+                      {"frame_interval_ns", interval_ns},
+                      {"dropped", (double)frames_dropped_} });
+    }
+    if (frames_out_ == 0) t_first_done_ = t_done;
+    t_last_done_ = t_done;
+    ++frames_out_;
     wait();
 
-    if (!ISP_QUIET) std::cout << "[ISP] Frame complete\n";
+    ISP_LOG(LOG_INFO, LOGC_ISP, "Frame " << frames_out_ << " complete (latency=" << lat
+                                << ", t=" << t_done << ")");
   }
 }
 
+void ISP_Canny::report() const {
+  if (!frames_out_) return;
+  std::cout << "[ISP] frames=" << frames_out_ << " dropped=" << frames_dropped_
+            << " latency_avg=" << (lat_sum_ / (double)frames_out_)
+            << " latency_max=" << lat_max_;
+  if (frames_out_ > 1) {
+    const sc_core::sc_time period = (t_last_done_ - t_first_done_) / (double)(frames_out_ - 1);
+    std::cout << " frame_interval=" << period;
+    if (period.value() > 0) std::cout << " throughput=" << 1.0 / period.to_seconds() << " fps";
+  }
+  std::cout << "\n";
+}
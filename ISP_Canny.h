@@ -1,12 +1,17 @@
 #pragma once
 #include <systemc>
 #include <vector>
+#include "PerfCounters.h"
+#include "Snapshot.h"
 
 // Forward declare the Verilated model (we include the real header in the .cpp)
 class VCannyEdge;
 
 // SystemC DE wrapper around the Verilated lab10 ISP (CannyEdge.v).
 // Consumes a frame on (pix_in,valid_in) and streams the processed frame out.
+// Frames are pipelined through ping-pong input/output buffers: ingest of
+// frame N+1, compute of frame N and stream-out of frame N-1 run in separate
+// clocked threads that hand buffers over through full/empty flags.
 struct ISP_Canny : sc_core::sc_module {
   // Clock (use the same DE clock as the rest of your top)
   sc_core::sc_in<bool> clk;
@@ -15,6 +20,11 @@ struct ISP_Canny : sc_core::sc_module {
   sc_core::sc_in< sc_dt::sc_uint<8> > pix_in;
   sc_core::sc_in<bool>                valid_in;
   sc_core::sc_in<bool>                vsync_in;
+  // Optional ready to an elastic source (SensorFifo_DE): a pixel is taken
+  // only at an edge where ready is high, ingest holds the source off instead
+  // of dropping frames, and a frame cut short by an early vsync is discarded
+  // and counted as dropped
+  sc_core::sc_port< sc_core::sc_signal_inout_if<bool>, 1, sc_core::SC_ZERO_OR_MORE_BOUND > ready_out;
 
   // Downstream pixel stream (to LUT)
   sc_core::sc_out< sc_dt::sc_uint<8> > pix_out;
@@ -25,6 +35,19 @@ struct ISP_Canny : sc_core::sc_module {
   ISP_Canny(sc_core::sc_module_name name, int width, int height);
   ~ISP_Canny() override;
 
+  void report() const;   // frame latency vs throughput, dropped frames
+  bool fixed_geometry() const { return fixed_geom_; }   // compile-time W x H passes
+  void set_perf(PerfCounters* p) { perf_ = p; }   // per-frame counters at stream-out
+
+  // Snapshot: last computed frame (input + per-stage buffers). Restoring it
+  // makes the next frame start warm, e.g. ISP_INCREMENTAL reuses clean tiles.
+  // The run usually stops with the next frame half computed, so with
+  // keep_snapshot() set each finished frame's buffers are copied aside and
+  // save_state() writes that copy.
+  void keep_snapshot(bool en) { keep_snap_ = en; }
+  void save_state(SnapBuf& s) const;
+  bool restore_state(SnapCursor& c);
+
 private:
   VCannyEdge* m_ = nullptr;
 
@@ -32,14 +55,61 @@ private:
   const int H_;
   const int N_; // W*H
 
-  std::vector<uint8_t> memX_, memXG_, Gxy_, Theta_, bGxy_;
+  // Ping-pong buffers (index = buffer, flags = full)
+  std::vector<uint8_t> memX_[2];          // input frames
+  std::vector<uint8_t> out_[2];           // finished frames
+  bool in_full_[2]  = {false, false};
+  bool out_full_[2] = {false, false};
+  int  in_wr_ = 0, in_rd_ = 0, out_wr_ = 0, out_rd_ = 0;
+  sc_core::sc_time in_t0_[2], out_t0_[2];  // first-pixel-in time per buffer
+  sc_core::sc_time out_busy_[2];           // compute time of the frame in each output buffer
+  uint64_t         out_cyc_[2] = {0, 0};   // RTL cycles of that frame
+
+  // Compute scratch (also the cache reused by incremental mode)
+  std::vector<uint8_t> memXG_, Gxy_, Theta_, nms_, bGxy_;
+
+  // Incremental mode (ISP_INCREMENTAL): per-stage recompute masks
+  std::vector<uint8_t> prev_in_;          // input of the last computed frame
+  std::vector<uint8_t> mask_[4];          // GAUSS, SOBEL, NMS, HYST
+  bool     have_prev_   = false;
+  uint64_t tiles_total_ = 0, tiles_dirty_ = 0;
+  void plan_incremental(const std::vector<uint8_t>& in);
 
-  // Helpers implemented in the .cpp
-  void run();
+  // Snapshot of the last finished frame (keep_snapshot)
+  bool    keep_snap_ = false;
+  SnapBuf settled_;
+  void pack_state(SnapBuf& s, bool have_prev) const;
+
+  // Frame statistics
+  uint64_t frames_out_ = 0, frames_dropped_ = 0;
+  sc_core::sc_time lat_sum_, lat_max_, t_first_done_, t_last_done_;
+  PerfCounters* perf_ = nullptr;
+
+  // Threads
+  void ingest();
+  void compute();
+  void stream_out();
+
+  // Compute passes per geometry (FrameGeometry.h): the production sensor
+  // sizes get compile-time W/H, anything else the runtime fallback
+  void (ISP_Canny::*passes_)(int) = nullptr;
+  bool fixed_geom_ = false;
+  template <class G> void passes(int b);
+  template <int R, class G>
+  void send_window(const G& g, const std::vector<uint8_t>& v, int i, int j, bool row_in);
 
   void tick();          // drive the Verilated clock +/- and wait()
   void reset_rtl();     // reset the RTL core
   void pulse_ce();      // emulate testbench chip-enable pulses
+  void op_strobe();     // bOPEnable low/high latch around a compute step
+
+  // Cycle accounting for ISP_LIGHT/ISP_ULTRA: count the clock cycles the
+  // full-handshake mode would spend and pay the difference with one
+  // aggregated wait(n) per row quantum, so simulated time matches.
+  uint64_t rtl_cycles_    = 0;   // cycles the full-handshake mode would use
+  uint64_t waited_cycles_ = 0;   // cycles actually waited in the compute loop
+  void yield();                  // wait() one clock and count it
+  void settle();                 // wait off the outstanding cycle debt
 
   inline uint8_t at(const std::vector<uint8_t>& v, int i, int j) const {
     if (i < 0 || j < 0 || i >= H_ || j >= W_) return 0;
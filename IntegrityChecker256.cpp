@@ -0,0 +1,196 @@
+#include "IntegrityChecker256.h"
+#include "Log.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+// ---------------------------------------------------------------- CRC32C
+
+#if !defined(__SSE4_2__)
+static const uint32_t* crc32c_table() {
+  static uint32_t t[256];
+  static bool init = false;
+  if (!init) {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) c = (c >> 1) ^ (0x82F63B78u & (0u - (c & 1u)));
+      t[i] = c;
+    }
+    init = true;
+  }
+  return t;
+}
+#endif
+
+uint32_t crc32c_update(uint32_t state, const uint8_t* p, size_t n) {
+#if defined(__SSE4_2__)
+  uint64_t c = state;
+  for (; n >= 8; n -= 8, p += 8) {
+    uint64_t w;
+    std::memcpy(&w, p, 8);
+    c = _mm_crc32_u64(c, w);
+  }
+  uint32_t s = (uint32_t)c;
+  for (; n; --n, ++p) s = _mm_crc32_u8(s, *p);
+  return s;
+#else
+  const uint32_t* t = crc32c_table();
+  for (; n; --n, ++p) state = t[(state ^ *p) & 0xFF] ^ (state >> 8);
+  return state;
+#endif
+}
+
+// ---------------------------------------------------------------- digest files
+
+bool parse_integrity_spec(const std::string& spec, IntegrityOptions& o) {
+  std::stringstream ss(spec);
+  std::string kv;
+  while (std::getline(ss, kv, ',')) {
+    if (kv.empty()) continue;
+    const size_t eq = kv.find('=');
+    const std::string k = kv.substr(0, eq);
+    const std::string v = (eq == std::string::npos) ? "" : kv.substr(eq + 1);
+    if      (k == "golden") o.golden = v;
+    else if (k == "write")  o.write  = v;
+    else {
+      std::cerr << "[WARN] Unknown integrity key '" << k << "'\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool load_digests(const std::string& path, std::vector<FrameDigest>& out) {
+  std::ifstream f(path);
+  if (!f) return false;
+  out.clear();
+  std::string line;
+  while (std::getline(f, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream ss(line);
+    std::string kw;
+    ss >> kw;
+    if (kw == "frame") {
+      unsigned idx = 0; std::string kb, kc;
+      FrameDigest d;
+      ss >> idx >> kb >> d.bytes >> kc >> std::hex >> d.crc;
+      if (!ss || kb != "bytes" || kc != "crc") return false;
+      out.push_back(d);
+    } else if (kw == "line" && !out.empty()) {
+      unsigned idx = 0; uint32_t c = 0;
+      ss >> idx >> std::hex >> c;
+      if (!ss || idx != out.back().lines.size()) return false;
+      out.back().lines.push_back(c);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool save_digests(const std::string& path, const std::vector<FrameDigest>& d) {
+  FILE* f = std::fopen(path.c_str(), "w");
+  if (!f) return false;
+  std::fprintf(f, "# CRC32C stream digests: frame <n> bytes <len> crc <hex>, then line <i> <hex>\n");
+  for (size_t k = 0; k < d.size(); ++k) {
+    std::fprintf(f, "frame %zu bytes %llu crc %08x\n", k, (unsigned long long)d[k].bytes, d[k].crc);
+    for (size_t i = 0; i < d[k].lines.size(); ++i) std::fprintf(f, "line %zu %08x\n", i, d[k].lines[i]);
+  }
+  std::fclose(f);
+  return true;
+}
+
+// ---------------------------------------------------------------- tap
+
+IntegrityChecker256::IntegrityChecker256(sc_core::sc_module_name name, uint32_t line_bytes)
+: sc_module(name), line_bytes_(line_bytes ? line_bytes : 32) {
+  SC_METHOD(run);
+  sensitive << clk.pos();
+  dont_initialize();
+}
+
+std::vector<IntegrityChecker256::Expect> IntegrityChecker256::expected() const {
+  std::vector<Expect> e;
+  const size_t k = done_.size();
+  if (ref_ && k < ref_->done_.size()) e.push_back(Expect{ &ref_->done_[k], ref_->name() });
+  if (have_golden_ && k < golden_.size()) e.push_back(Expect{ &golden_[k], "golden" });
+  return e;
+}
+
+void IntegrityChecker256::mismatch(const char* what, int64_t line, uint32_t got, uint32_t want, const char* who) {
+  // from the clocked process: through the log ring, stamped with sim time
+  if (mismatches_++ < MAX_REPORTED)
+    ISP_LOG(LOG_WARN, LOGC_INTEGRITY, name() << " frame " << done_.size() << " " << what
+              << (line >= 0 ? " " + std::to_string(line) : std::string()) << " mismatch vs " << who << " at beat " << beats_
+              << std::hex << " crc=" << got << " expected=" << want << std::dec);
+}
+
+void IntegrityChecker256::end_line() {
+  const uint32_t crc = ~line_crc_;
+  const size_t i = cur_.lines.size();
+  cur_.lines.push_back(crc);
+  line_crc_  = CRC32C_INIT;
+  line_fill_ = 0;
+
+  for (const Expect& e : expected())
+    if (i < e.d->lines.size() && e.d->lines[i] != crc) mismatch("line", (int64_t)i, crc, e.d->lines[i], e.who);
+}
+
+void IntegrityChecker256::end_frame() {
+  if (line_fill_) end_line();
+  cur_.crc = ~frame_crc_;
+
+  for (const Expect& e : expected())
+    if (e.d->crc != cur_.crc || e.d->bytes != cur_.bytes) mismatch("crc", -1, cur_.crc, e.d->crc, e.who);
+
+  done_.push_back(cur_);
+  cur_ = FrameDigest();
+  frame_crc_ = CRC32C_INIT;
+}
+
+void IntegrityChecker256::run() {
+  if (!(valid_in.read() && ready_in.read())) return;
+
+  // frame length: fixed, else the reference's committed size, else last_in
+  uint64_t limit = frame_bytes_;
+  if (!limit && ref_ && done_.size() < ref_->done_.size()) limit = ref_->done_[done_.size()].bytes;
+
+  const sc_dt::sc_bv<256> v = data_in.read();
+  uint8_t b[32];
+  for (int i = 0; i < 32; ++i) b[i] = (uint8_t)v.range(8*i+7, 8*i).to_uint();
+  ++beats_;
+
+  uint32_t take = 32;
+  if (limit && cur_.bytes + take > limit) take = (uint32_t)(limit - cur_.bytes);   // rest is padding
+  frame_crc_ = crc32c_update(frame_crc_, b, take);
+  for (uint32_t off = 0; off < take; ) {
+    const uint32_t n = std::min(take - off, line_bytes_ - line_fill_);
+    line_crc_ = crc32c_update(line_crc_, b + off, n);
+    line_fill_ += n;
+    off += n;
+    if (line_fill_ == line_bytes_) end_line();
+  }
+  cur_.bytes += take;
+
+  if ((limit && cur_.bytes >= limit) || (!limit && last_in.read())) end_frame();
+}
+
+void IntegrityChecker256::report() const {
+  std::cout << "[INTEGRITY] " << name() << " beats=" << beats_ << " frames=" << done_.size();
+  if (!done_.empty())
+    std::cout << " last_crc=" << std::hex << done_.back().crc << std::dec
+              << " (" << done_.back().bytes << " B, " << done_.back().lines.size() << " lines)";
+  if (cur_.bytes) std::cout << " partial=" << cur_.bytes << " B";
+  std::cout << " mismatches=" << mismatches_;
+  if (have_golden_ && done_.size() < golden_.size())
+    std::cout << " (golden has " << golden_.size() << " frames)";
+  if (ref_ && done_.size() < ref_->done_.size())
+    std::cout << " (" << ref_->name() << " has " << ref_->done_.size() << " frames)";
+  std::cout << (ok() ? " OK" : " FAIL") << "\n";
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <systemc>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// CRC32C (Castagnoli). crc32c_update() runs on the raw register: start
+// from CRC32C_INIT and finish with ~state. SSE4.2 crc32 instruction when
+// available, else a byte table.
+static constexpr uint32_t CRC32C_INIT = 0xFFFFFFFFu;
+uint32_t crc32c_update(uint32_t state, const uint8_t* p, size_t n);
+
+// Digests of one frame on a 256-bit stream
+struct FrameDigest {
+  uint64_t bytes = 0;
+  uint32_t crc   = 0;
+  std::vector<uint32_t> lines;        // one CRC per line_bytes segment
+};
+
+// CLI form: --integrity[=golden=<file>][,write=<file>]
+struct IntegrityOptions {
+  std::string golden;                 // compare the packer-output digests
+  std::string write;                  // save them (e.g. to make a golden file)
+};
+bool parse_integrity_spec(const std::string& spec, IntegrityOptions& o);
+
+bool load_digests(const std::string& path, std::vector<FrameDigest>& out);
+bool save_digests(const std::string& path, const std::vector<FrameDigest>& d);
+
+// Passive streaming checksum tap on a valid/ready 256-bit interface (a beat
+// is valid && ready at the edge, as BusMonitor256). Each frame is hashed
+// beat by beat into a frame CRC and per-line CRCs; only the digests are
+// kept. A frame ends after set_frame_bytes() bytes, on last_in, or after the
+// byte count of the matching frame of the reference tap. Completed lines and
+// frames are compared against the reference tap (e.g. the read side against
+// the packer output) and against golden digests; mismatches are reported
+// with beat index and time.
+struct IntegrityChecker256 : sc_core::sc_module {
+  sc_core::sc_in<bool>                clk;
+  sc_core::sc_in< sc_dt::sc_bv<256> > data_in;
+  sc_core::sc_in<bool>                valid_in;
+  sc_core::sc_in<bool>                ready_in;
+  sc_core::sc_in<bool>                last_in;    // frame end when the size is not known up front
+
+  SC_HAS_PROCESS(IntegrityChecker256);
+  IntegrityChecker256(sc_core::sc_module_name name, uint32_t line_bytes);
+
+  void set_frame_bytes(uint32_t n) { frame_bytes_ = n; }     // 0: last_in / reference
+  void set_reference(const IntegrityChecker256* ref) { ref_ = ref; }
+  void set_golden(const std::vector<FrameDigest>& g) { golden_ = g; have_golden_ = true; }
+
+  const std::vector<FrameDigest>& digests() const { return done_; }
+  // no mismatch, every golden frame seen, and a reference tap's frames all
+  // closed here (a partial or missing frame was never compared)
+  bool ok() const {
+    return mismatches_ == 0 && (!have_golden_ || done_.size() >= golden_.size()) &&
+           (!ref_ || (cur_.bytes == 0 && done_.size() >= ref_->done_.size()));
+  }
+  void report() const;
+
+private:
+  const uint32_t line_bytes_;
+  uint32_t frame_bytes_ = 0;
+  const IntegrityChecker256* ref_ = nullptr;
+  std::vector<FrameDigest> golden_;
+  bool have_golden_ = false;
+
+  // Frame in progress
+  FrameDigest cur_;
+  uint32_t frame_crc_ = CRC32C_INIT, line_crc_ = CRC32C_INIT;
+  uint32_t line_fill_ = 0;
+  std::vector<FrameDigest> done_;
+
+  uint64_t beats_ = 0, mismatches_ = 0;
+  static constexpr unsigned MAX_REPORTED = 8;
+
+  struct Expect { const FrameDigest* d; const char* who; };
+  std::vector<Expect> expected() const;   // reference / golden digests of the current frame
+  void end_line();
+  void end_frame();
+  void mismatch(const char* what, int64_t line, uint32_t got, uint32_t want, const char* who);
+  void run();
+};
@@ -1,16 +1,29 @@
 #include "LPDDR.h"
+#include <algorithm>
 using sc_core::SC_NS;
 using sc_core::sc_time;
 using sc_core::sc_time_stamp;
 
-LPDDR::LPDDR(sc_core::sc_module_name name) : sc_module(name) {
+LPDDR::LPDDR(sc_core::sc_module_name name) : sc_module(name), waddr("waddr"), raddr("raddr") {
   SC_CTHREAD(run, clk.pos());
+  set_streams(std::vector<uint32_t>(1, 0));
 }
 
 void LPDDR::set_expected_bytes(uint32_t n) {
-  expected_bytes_ = n;
-  mem_.clear();
-  mem_.reserve(n);
+  set_streams(std::vector<uint32_t>(1, n));
+}
+
+void LPDDR::set_streams(const std::vector<uint32_t>& bytes) {
+  streams_.assign(bytes.empty() ? 1 : bytes.size(), Stream());
+  expected_bytes_ = 0;
+  for (size_t i=0; i<bytes.size(); ++i) {
+    streams_[i].expected = bytes[i];
+    streams_[i].mem.reserve(bytes[i]);
+    expected_bytes_ += bytes[i];
+  }
+  streams_done_ = 0;
+  rd_cat_.clear();
+  rd_src_ = nullptr;
   wr_bytes_ = 0;
   wr_bursts_ = 0;
   wr_started_ = false;
@@ -19,13 +32,32 @@ void LPDDR::set_expected_bytes(uint32_t n) {
   rd_phase_ = false;
 }
 
+void LPDDR::set_dma(const DmaDescriptor& d) {
+  dma_on_ = true;
+  dma_    = d;
+  canvas_.assign((size_t)(dma_.end() - dma_.config().base), 0);
+  dma_wr_ = DramAccessStats();
+  dma_rd_ = DramAccessStats();
+}
+
+void LPDDR::set_traffic_mode(unsigned act_cycles) {
+  traffic_ = true;
+  tr_act_  = act_cycles;
+}
+
 void LPDDR::reset_counters() {
   wr_bytes_ = wr_bursts_ = 0;
   wr_started_ = wr_done_ = false;
   rd_idx_ = 0;
+  wr_busy_ = wr_idle_ = rd_busy_ = rd_idle_ = 0;
 }
 
 void LPDDR::report() const {
+  if (traffic_) {
+    std::cout << "[LPDDR] TRAFFIC wr_beats=" << wr_bursts_ << " rd_beats=" << tr_rd_beats_
+              << " row_acts=" << tr_acts_ << " act_stall_cycles=" << tr_stall_ << "\n";
+    return;
+  }
   double wr_gbps = 0.0, rd_gbps = 0.0;
   if (wr_started_) {
     sc_time dt = wr_t1_ - wr_t0_;
@@ -42,10 +74,93 @@ void LPDDR::report() const {
     std::cout << "[LPDDR] READ   bytes_rd=" << expected_bytes_
               << " throughput=" << rd_gbps << " GB/s\n";
   }
+  if (dma_on_) {
+    std::cout << "[DMA] Layout " << dma_.describe() << " (" << canvas_.size() << " B region)\n";
+    dma_wr_.report("WRITE", dma_.config().act_cycles);
+    dma_rd_.report("READ ", dma_.config().act_cycles);
+  }
 }
 
 void LPDDR::read_back(std::vector<uint8_t>& out) const {
-  out = mem_;
+  read_back(0, out);
+}
+
+void LPDDR::read_back(unsigned sid, std::vector<uint8_t>& out) const {
+  if (sid >= streams_.size()) { out.clear(); return; }
+  if (sid != 0 || !dma_on_) { out = streams_[sid].mem; return; }
+  // gather the raster frame back from its storage addresses
+  const uint64_t base = dma_.config().base;
+  out.resize(streams_[0].mem.size());
+  for (uint32_t i = 0; i < out.size(); ++i) out[i] = canvas_[dma_.write_addr(i) - base];
+}
+
+void LPDDR::arm_read() {
+  // committed sizes; single stream reads in place, else concatenated
+  expected_bytes_ = 0;
+  for (const auto& s2 : streams_) expected_bytes_ += s2.expected;
+  if (dma_on_) {
+    // stream 0 in the descriptor's read order, other streams appended as is
+    const uint64_t base = dma_.config().base;
+    rd_cat_.resize(streams_[0].expected);
+    for (uint32_t i = 0; i < streams_[0].expected; ++i) rd_cat_[i] = canvas_[dma_.read_addr(i) - base];
+    for (size_t k = 1; k < streams_.size(); ++k)
+      rd_cat_.insert(rd_cat_.end(), streams_[k].mem.begin(), streams_[k].mem.end());
+    rd_src_ = &rd_cat_;
+  } else if (streams_.size() == 1) {
+    rd_src_ = &streams_[0].mem;
+  } else {
+    rd_cat_.clear();
+    for (const auto& s2 : streams_) rd_cat_.insert(rd_cat_.end(), s2.mem.begin(), s2.mem.end());
+    rd_src_ = &rd_cat_;
+  }
+  rd_phase_ = true;
+  rd_idx_   = 0;
+  rd_t0_    = sc_time_stamp();
+}
+
+void LPDDR::save_state(SnapBuf& s) const {
+  s.u32((uint32_t)streams_.size());
+  for (const Stream& st : streams_) {
+    s.u32(st.expected);
+    s.u8(st.done ? 1 : 0);
+    s.bytes(st.mem);
+  }
+  s.u64(wr_bytes_);
+  s.u64(wr_bursts_);
+  s.f64(wr_started_ ? (wr_t1_ - wr_t0_).to_seconds() : 0.0);   // write duration
+}
+
+bool LPDDR::restore_state(SnapCursor& c) {
+  const uint32_t n = c.u32();
+  if (!c.ok() || n == 0) return false;
+  std::vector<Stream> st(n);
+  for (Stream& x : st) {
+    x.expected = c.u32();
+    x.done     = c.u8() != 0;
+    c.bytes(x.mem);
+  }
+  const uint64_t wr_bytes  = c.u64();
+  const uint64_t wr_bursts = c.u64();
+  const double   wr_secs   = c.f64();
+  if (!c.ok()) return false;
+
+  streams_.swap(st);
+  streams_done_ = 0;
+  for (const Stream& x : streams_) streams_done_ += x.done ? 1 : 0;
+  wr_bytes_   = wr_bytes;
+  wr_bursts_  = wr_bursts;
+  wr_started_ = wr_bytes_ > 0;
+  wr_t0_      = sc_core::SC_ZERO_TIME;
+  wr_t1_      = sc_time(wr_secs * 1e12, sc_core::SC_PS);
+  wr_done_    = streams_done_ == streams_.size();
+  rd_phase_   = false;
+  if (dma_on_) {
+    const uint64_t base = dma_.config().base;
+    const std::vector<uint8_t>& m = streams_[0].mem;
+    for (uint32_t i = 0; i < m.size() && i < dma_.bytes(); ++i) canvas_[dma_.write_addr(i) - base] = m[i];
+  }
+  if (wr_done_) arm_read();
+  return true;
 }
 
 void LPDDR::run() {
@@ -56,46 +171,97 @@ void LPDDR::run() {
   wait();
 
   for (;;) {
+    if (traffic_) { traffic_step(); wait(); continue; }
+    if (perf_) pclk_.edge();
+
     // ---------------------- WRITE path ----------------------
-    if (wvalid.read() && wready.read()) {
+    const bool wr_beat = wvalid.read() && wready.read();
+    if (perf_ && (wr_started_ || wr_beat) && !wr_done_) { if (wr_beat) ++wr_busy_; else ++wr_idle_; }
+    if (wr_beat) {
       if (!wr_started_) { wr_started_ = true; wr_t0_ = sc_time_stamp(); }
 
       const sc_dt::sc_bv<256> v = wdata.read();
-      // append up to expected_bytes_ bytes (clip last burst if partial)
-      const uint32_t room = (expected_bytes_ > mem_.size()) ? (expected_bytes_ - (uint32_t)mem_.size()) : 0;
+      const unsigned sid = std::min<unsigned>(wid.read().to_uint(), (unsigned)streams_.size() - 1);
+      Stream& st = streams_[sid];
+      // append up to the stream's expected bytes (clip last burst if partial)
+      const uint32_t room = (st.expected > st.mem.size()) ? (st.expected - (uint32_t)st.mem.size()) : 0;
       const uint32_t take = room >= 32 ? 32u : room;
-      for (uint32_t i=0; i<take; ++i) mem_.push_back(get_byte(v, i));
+      const bool dma = dma_on_ && sid == 0;
+      if (energy_) {
+        ++energy_->c.dram_wr;
+        access_row(dma ? dma_.write_addr((uint32_t)st.mem.size()) : ((uint64_t)sid << 32) + st.mem.size());
+      }
+      for (uint32_t i=0; i<take; ++i) {
+        const uint8_t b = get_byte(v, i);
+        if (dma) {
+          const uint64_t a = dma_.write_addr((uint32_t)st.mem.size());
+          canvas_[a - dma_.config().base] = b;
+          dma_wr_.access(a, EnergyMeter::DRAM_ROW_BYTES);
+        }
+        st.mem.push_back(b);
+      }
+      if (dma) dma_wr_.end_beat();
 
       wr_bytes_  += take;
       wr_bursts_ += 1;
 
-      if (wr_bytes_ >= expected_bytes_ && !wr_done_) {
+      // wlast commits a variable-length (e.g. compressed) frame early
+      if (wlast.read() && !st.done) st.expected = (uint32_t)st.mem.size();
+      if (st.mem.size() >= st.expected && !st.done) { st.done = true; ++streams_done_; }
+
+      if (streams_done_ == streams_.size() && !wr_done_) {
         wr_done_ = true;
         wr_t1_   = sc_time_stamp();
-        // arm read-out on next cycles
-        rd_phase_ = true;
-        rd_idx_   = 0;
-        rd_t0_    = sc_time_stamp();
+        arm_read();   // read-out starts on the next cycles
+        if (perf_)
+          perf_->record("lpddr_wr", 1, pclk_.cycles(wr_busy_),
+                        { {"bytes", (double)wr_bytes_},
+                          {"beats", (double)wr_bursts_},
+                          {"busy_cycles", (double)wr_busy_},
+                          {"idle_cycles", (double)wr_idle_} });
       }
     }
 
     // ---------------------- READ path -----------------------
+    bool rd_beat = false;
     if (rd_phase_) {
       if (rd_idx_ < expected_bytes_) {
         sc_dt::sc_bv<256> out;
         // pack next 32 bytes (clip on last burst)
         const uint32_t remain = expected_bytes_ - rd_idx_;
         const uint32_t take   = remain >= 32 ? 32u : remain;
-        for (uint32_t i=0; i<take; ++i) set_byte(out, i, mem_[rd_idx_ + i]);
+        for (uint32_t i=0; i<take; ++i) set_byte(out, i, (*rd_src_)[rd_idx_ + i]);
 
         rdata.write(out);
         rvalid.write(true);
 
+        if (perf_) { if (rready.read()) ++rd_busy_; else ++rd_idle_; }
+        const bool dma = dma_on_ && rd_idx_ < streams_[0].expected;
+        if (energy_ && rready.read()) {
+          ++energy_->c.dram_rd; rd_beat = true;
+          access_row(dma ? dma_.read_addr(rd_idx_) : rd_idx_);
+        }
         if (rready.read()) {
+          if (dma) {
+            for (uint32_t i=0; i<take && rd_idx_ + i < streams_[0].expected; ++i)
+              dma_rd_.access(dma_.read_addr(rd_idx_ + i), EnergyMeter::DRAM_ROW_BYTES);
+            dma_rd_.end_beat();
+          }
           rd_idx_ += take;
           if (rd_idx_ >= expected_bytes_) {
-            rvalid.write(false);
             rd_t1_ = sc_time_stamp();
+            if (perf_)
+              perf_->record("lpddr_rd", 1, pclk_.cycles(rd_busy_),
+                            { {"bytes", (double)expected_bytes_},
+                              {"busy_cycles", (double)rd_busy_},
+                              {"idle_cycles", (double)rd_idle_} });
+            // the last beat is seen by the consumer at the next edge: keep
+            // it valid until that edge accepts it, then deassert and stop
+            do wait(); while (!rready.read());
+            rvalid.write(false);
+            // the frame's energy includes its read-out
+            if (energy_) energy_->frame_end(energy_->written() ? energy_->written() : expected_bytes_);
+            if (drain_cycles_) wait(drain_cycles_);
             sc_core::sc_stop(); 
             // We’re done; let the testbench decide when to sc_stop().
             // (Your main.cpp prints PGM and calls report() after sc_start().)
@@ -107,8 +273,47 @@ void LPDDR::run() {
     } else {
       rvalid.write(false);
     }
+    if (energy_ && !wr_beat && !rd_beat) ++energy_->c.dram_idle;
 
     wait();
   }
 }
 
+
+void LPDDR::traffic_step() {
+  // the bus is held while a row activation is in progress
+  const bool bus_free = tr_busy_ == 0;
+  if (!bus_free) { --tr_busy_; ++tr_stall_; }
+
+  // read request (rready) is queued; unbound raddr reads sequentially
+  if (rready.read())
+    tr_rq_.push_back(raddr.size() ? raddr->read() : (uint64_t)(tr_rd_beats_ + tr_rq_.size()) * 32);
+
+  // wready was driven low while busy, so a write beat implies a free bus
+  const bool wr_beat = bus_free && wvalid.read() && wready.read();
+  const bool rd_beat = bus_free && !wr_beat && !tr_rq_.empty();
+  uint64_t a = 0;
+  if (wr_beat) {
+    a = waddr.size() ? waddr->read() : wr_bytes_;
+    wr_bytes_ += 32; ++wr_bursts_;
+    if (energy_) ++energy_->c.dram_wr;
+  } else if (rd_beat) {
+    a = tr_rq_.front();
+    tr_rq_.pop_front();
+    sc_dt::sc_bv<256> out;
+    for (int i = 0; i < 8; ++i) set_byte(out, i, (uint8_t)(a >> (8*i)));
+    rdata.write(out);
+    ++tr_rd_beats_;
+    if (energy_) ++energy_->c.dram_rd;
+  }
+  rvalid.write(rd_beat);
+
+  if (wr_beat || rd_beat) {
+    if (energy_) access_row(a);
+    const uint64_t row = a / EnergyMeter::DRAM_ROW_BYTES;
+    if (row != tr_row_) { ++tr_acts_; tr_row_ = row; tr_busy_ = tr_act_; }
+  } else if (energy_) {
+    ++energy_->c.dram_idle;
+  }
+  wready.write(tr_busy_ == 0);
+}
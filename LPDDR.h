@@ -1,9 +1,14 @@
 #pragma once
 #include <systemc>
 #include <vector>
+#include <deque>
 #include <cstdint>
 #include <string>
 #include <iostream>
+#include "PerfCounters.h"
+#include "Snapshot.h"
+#include "EnergyModel.h"
+#include "DmaDescriptor.h"
 
 struct LPDDR : sc_core::sc_module {
   // Clock
@@ -12,6 +17,8 @@ struct LPDDR : sc_core::sc_module {
   // 256-bit write channel (from packer)
   sc_core::sc_in< sc_dt::sc_bv<256> > wdata;
   sc_core::sc_in<bool>                wvalid;
+  sc_core::sc_in<bool>                wlast;    // last beat of the frame (commits a short frame)
+  sc_core::sc_in< sc_dt::sc_uint<8> > wid;      // source stream id (multi-camera arbiter), else 0
   sc_core::sc_out<bool>               wready;
 
   // 256-bit read channel (to a consumer)
@@ -19,21 +26,54 @@ struct LPDDR : sc_core::sc_module {
   sc_core::sc_out<bool>                rvalid;
   sc_core::sc_in<bool>                 rready;
 
+  // Optional beat addresses (traffic generator); unbound ports keep the
+  // frame-offset / descriptor addressing
+  sc_core::sc_port< sc_core::sc_signal_in_if<uint64_t>, 1, sc_core::SC_ZERO_OR_MORE_BOUND > waddr;
+  sc_core::sc_port< sc_core::sc_signal_in_if<uint64_t>, 1, sc_core::SC_ZERO_OR_MORE_BOUND > raddr;
+
   SC_HAS_PROCESS(LPDDR);
   LPDDR(sc_core::sc_module_name name);
 
   // Control / host helpers
-  void set_expected_bytes(uint32_t n);
+  void set_expected_bytes(uint32_t n);       // frame size, or capacity when wlast delimits frames
+  void set_streams(const std::vector<uint32_t>& bytes);  // one write stream per wid
   void reset_counters();
+  void set_stop_drain_cycles(unsigned n) { drain_cycles_ = n; } // let CDC FIFOs empty before sc_stop
   void report() const;
+  void set_perf(PerfCounters* p) { perf_ = p; }   // write/read busy+idle cycles per frame
+  void set_energy(EnergyMeter* e) { energy_ = e; } // activate/read/write/idle command counts
+  void set_dma(const DmaDescriptor& d);          // stream 0 stored / read through a 2D descriptor
+
+  // Traffic mode: no storage or frame phases. rready/raddr become a read
+  // request (always accepted, queued in order; the master bounds its
+  // outstanding reads), writes and read responses share one beat per cycle
+  // (writes first), and a beat to a new row holds the bus for act_cycles.
+  // rdata carries the beat address in its low 8 bytes. The master stops the
+  // simulation.
+  void set_traffic_mode(unsigned act_cycles);
 
   // Host-side peek (unchanged behavior for your PGM write-back)
-  void read_back(std::vector<uint8_t>& out) const;
+  void read_back(std::vector<uint8_t>& out) const;              // stream 0
+  void read_back(unsigned sid, std::vector<uint8_t>& out) const;
+  uint32_t committed_bytes() const { return expected_bytes_; }
+
+  // Snapshot: stream contents + write counters. Restoring a fully written
+  // snapshot arms the read phase, so the run starts at the first read beat.
+  void save_state(SnapBuf& s) const;
+  bool restore_state(SnapCursor& c);
 
 private:
-  // Storage
-  std::vector<uint8_t> mem_;          // last written frame
-  uint32_t expected_bytes_ = 0;
+  // Storage: one region per write stream, read back in stream order
+  struct Stream {
+    std::vector<uint8_t> mem;         // last written frame
+    uint32_t expected = 0;
+    bool     done     = false;
+  };
+  std::vector<Stream> streams_;
+  unsigned streams_done_ = 0;
+  std::vector<uint8_t> rd_cat_;       // streams concatenated for the read phase (n > 1)
+  const std::vector<uint8_t>* rd_src_ = nullptr;
+  uint32_t expected_bytes_ = 0;       // total over all streams
 
   // Write counters
   uint64_t wr_bytes_ = 0;
@@ -46,9 +86,38 @@ private:
   uint32_t rd_idx_ = 0;
   bool     rd_phase_ = false;
   sc_core::sc_time rd_t0_, rd_t1_;
+  unsigned drain_cycles_ = 0;
+
+  // Perf counters (first beat .. frame committed / read-out complete)
+  PerfCounters* perf_ = nullptr;
+  PerfClock     pclk_;
+  uint64_t wr_busy_ = 0, wr_idle_ = 0, rd_busy_ = 0, rd_idle_ = 0;
+
+  // 2D DMA: stream 0 bytes land at descriptor addresses in canvas_ (offset
+  // from base); reads walk it in the descriptor's read order
+  bool            dma_on_ = false;
+  DmaDescriptor   dma_;
+  std::vector<uint8_t> canvas_;
+  DramAccessStats dma_wr_, dma_rd_;
+
+  // Traffic mode
+  bool     traffic_ = false;
+  unsigned tr_act_ = 0, tr_busy_ = 0;
+  uint64_t tr_row_ = ~0ull, tr_acts_ = 0, tr_stall_ = 0, tr_rd_beats_ = 0;
+  std::deque<uint64_t> tr_rq_;        // pending read requests
+  void traffic_step();
+
+  // Energy: single open row (open-page policy), activation on a row change
+  EnergyMeter* energy_ = nullptr;
+  uint64_t     open_row_ = ~0ull;
+  void access_row(uint64_t addr) {
+    const uint64_t row = addr / EnergyMeter::DRAM_ROW_BYTES;
+    if (row != open_row_) { ++energy_->c.dram_act; open_row_ = row; }
+  }
 
   // Process
   void run();
+  void arm_read();     // all streams committed: set up the read-out
 
   // Helpers
   static inline uint8_t get_byte(const sc_dt::sc_bv<256>& v, int i) {
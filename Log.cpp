@@ -0,0 +1,180 @@
+#include "Log.h"
+#include <systemc>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace Log {
+
+uint8_t threshold[LOGC_COUNT] = { LOG_INFO, LOG_INFO, LOG_INFO, LOG_INFO, LOG_INFO,
+                                  LOG_INFO, LOG_INFO, LOG_INFO, LOG_INFO, LOG_INFO };
+
+static const char* const CAT_TAG[LOGC_COUNT] = {
+  "PIPE", "SENSOR", "ISP", "CMP", "DECOMP", "LPDDR", "PCIEDMA", "READSINK", "ENERGY", "INTEGRITY" };
+static const char* const CAT_KEY[LOGC_COUNT] = {
+  "pipe", "sensor", "isp", "cmp", "decomp", "lpddr", "dma", "rsink", "energy", "integrity" };
+static const char* const LEVEL_KEY[] = { "error", "warn", "info", "debug", "trace" };
+
+const char* cat_tag(int cat) { return (cat >= 0 && cat < LOGC_COUNT) ? CAT_TAG[cat] : "LOG"; }
+
+static int parse_level(const std::string& s) {
+  for (int i = 0; i <= LOG_TRACE; ++i)
+    if (s == LEVEL_KEY[i]) return i;
+  return -1;
+}
+
+bool configure(const std::string& spec) {
+  std::stringstream ss(spec);
+  std::string tok;
+  bool ok = true;
+  while (std::getline(ss, tok, ',')) {
+    if (tok.empty()) continue;
+    const size_t eq = tok.find('=');
+    const int lvl = parse_level(eq == std::string::npos ? tok : tok.substr(eq + 1));
+    if (lvl < 0) { ok = false; continue; }
+    if (eq == std::string::npos) {
+      for (uint8_t& t : threshold) t = (uint8_t)lvl;
+      continue;
+    }
+    const std::string cat = tok.substr(0, eq);
+    bool found = false;
+    for (int c = 0; c < LOGC_COUNT; ++c)
+      if (cat == CAT_KEY[c]) { threshold[c] = (uint8_t)lvl; found = true; }
+    ok = ok && found;
+  }
+  return ok;
+}
+
+// ---------------------------------------------------------------- ring
+// Bounded MPMC queue (per-cell sequence numbers); only the drain thread pops.
+static constexpr size_t RING = 4096;
+struct Cell { std::atomic<size_t> seq; LogRecord rec; };
+static Cell                 g_cells[RING];
+static std::atomic<size_t>  g_enq{0};
+static size_t               g_deq = 0;              // drain thread only
+static std::atomic<size_t>  g_done{0};              // records written
+static std::atomic<uint64_t> g_full_waits{0};
+static std::atomic<bool>    g_run{false};
+static std::thread          g_thread;
+static std::FILE*           g_out = nullptr;
+static bool                 g_bin = false, g_time = false, g_own = false;
+static std::vector<char>    g_buf;
+
+static void write_record(const LogRecord& r) {
+  if (g_bin) {
+    std::fwrite(&r.t_ps, 8, 1, g_out);
+    std::fwrite(&r.level, 1, 1, g_out);
+    std::fwrite(&r.cat, 1, 1, g_out);
+    std::fwrite(&r.len, 2, 1, g_out);
+    std::fwrite(r.text, 1, r.len, g_out);
+    return;
+  }
+  if (g_time) std::fprintf(g_out, "@%.3f ns ", (double)r.t_ps / 1000.0);
+  std::fprintf(g_out, "[%s] %.*s", cat_tag(r.cat), (int)r.len, r.text);
+  if (!r.len || r.text[r.len - 1] != '\n') std::fputc('\n', g_out);
+}
+
+static bool drain_some() {
+  bool any = false;
+  for (;;) {
+    Cell& c = g_cells[g_deq & (RING - 1)];
+    if (c.seq.load(std::memory_order_acquire) != g_deq + 1) break;
+    write_record(c.rec);
+    c.seq.store(g_deq + RING, std::memory_order_release);
+    ++g_deq;
+    any = true;
+  }
+  if (any) {
+    std::fflush(g_out);
+    g_done.store(g_deq, std::memory_order_release);
+  }
+  return any;
+}
+
+static void drain_loop() {
+  while (g_run.load(std::memory_order_acquire))
+    if (!drain_some()) std::this_thread::sleep_for(std::chrono::microseconds(200));
+  drain_some();
+}
+
+bool start(const std::string& path, bool with_time) {
+  if (g_run.load()) return true;
+  for (size_t i = 0; i < RING; ++i) g_cells[i].seq.store(i, std::memory_order_relaxed);
+  g_bin  = path.size() > 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+  g_time = with_time;
+  g_own  = !path.empty();
+  g_out  = g_own ? std::fopen(path.c_str(), g_bin ? "wb" : "w") : stdout;
+  if (!g_out) { g_out = stdout; g_own = false; g_bin = false; return false; }
+  if (g_own) {
+    g_buf.resize(1 << 20);
+    std::setvbuf(g_out, g_buf.data(), _IOFBF, g_buf.size());
+  }
+  if (g_bin) std::fwrite("ISPLOG1\0", 1, 8, g_out);
+  g_run.store(true, std::memory_order_release);
+  g_thread = std::thread(drain_loop);
+  return true;
+}
+
+void push(const LogRecord& r) {
+  if (!g_run.load(std::memory_order_acquire)) {     // not started: write through
+    std::printf("[%s] %.*s", cat_tag(r.cat), (int)r.len, r.text);
+    if (!r.len || r.text[r.len - 1] != '\n') std::putchar('\n');
+    return;
+  }
+  size_t pos = g_enq.load(std::memory_order_relaxed);
+  Cell* c;
+  for (;;) {
+    c = &g_cells[pos & (RING - 1)];
+    const size_t seq = c->seq.load(std::memory_order_acquire);
+    const intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+    if (dif == 0) {
+      if (g_enq.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    } else if (dif < 0) {                           // full: wait for the drain
+      g_full_waits.fetch_add(1, std::memory_order_relaxed);
+      std::this_thread::yield();
+      pos = g_enq.load(std::memory_order_relaxed);
+    } else {
+      pos = g_enq.load(std::memory_order_relaxed);
+    }
+  }
+  c->rec = r;
+  c->seq.store(pos + 1, std::memory_order_release);
+}
+
+void flush() {
+  if (!g_run.load()) { std::fflush(stdout); return; }
+  const size_t target = g_enq.load(std::memory_order_acquire);
+  while (g_done.load(std::memory_order_acquire) < target)
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+}
+
+void stop() {
+  if (!g_run.load()) return;
+  flush();
+  g_run.store(false, std::memory_order_release);
+  g_thread.join();
+  if (g_own) std::fclose(g_out);
+  g_out = nullptr;
+  if (g_full_waits.load())
+    std::fprintf(stderr, "[LOG] ring full, producers waited %llu times\n",
+                 (unsigned long long)g_full_waits.load());
+}
+
+} // namespace Log
+
+LogLine::LogLine(int level, int cat) : std::ostream(static_cast<std::streambuf*>(this)) {
+  r_.t_ps  = (uint64_t)(sc_core::sc_time_stamp().to_seconds() * 1e12 + 0.5);
+  r_.level = (uint8_t)level;
+  r_.cat   = (uint8_t)cat;
+  r_.len   = 0;
+  setp(r_.text, r_.text + sizeof(r_.text));
+}
+
+LogLine::~LogLine() {
+  r_.len = (uint16_t)(pptr() - pbase());
+  Log::push(r_);
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+// Buffered logging for messages printed from inside simulation processes.
+// ISP_LOG() formats into a fixed 128-byte record stamped with the simulation
+// time and pushes it into a lock-free ring; a drain thread writes the records
+// as text ("[TAG] message", optional "@time" prefix) or binary, so a verbose
+// run costs no syscall per line. Call Log::flush() before printing reports
+// with std::cout so the two streams stay in order.
+//
+// Runtime filter (--log= or ISP_LOG): "<level>" or "<level>,<cat>=<level>,...",
+// e.g. "warn,isp=debug". Levels: error warn info debug trace (default info).
+// Build-time filter: -DISP_LOG_MAX_LEVEL=<n> and -DISP_LOG_CATS=<bitmask>
+// drop records before any formatting code is emitted.
+enum LogLevel { LOG_ERROR = 0, LOG_WARN, LOG_INFO, LOG_DEBUG, LOG_TRACE };
+enum LogCat   { LOGC_PIPE = 0, LOGC_SENSOR, LOGC_ISP, LOGC_CMP, LOGC_DECOMP,
+                LOGC_LPDDR, LOGC_DMA, LOGC_READ, LOGC_ENERGY, LOGC_INTEGRITY,
+                LOGC_COUNT };
+
+#ifndef ISP_LOG_MAX_LEVEL
+#define ISP_LOG_MAX_LEVEL LOG_DEBUG
+#endif
+#ifndef ISP_LOG_CATS
+#define ISP_LOG_CATS 0xffffffffu
+#endif
+
+constexpr bool log_compiled(int level, int cat) {
+  return level <= ISP_LOG_MAX_LEVEL && ((ISP_LOG_CATS >> cat) & 1u);
+}
+
+struct LogRecord {
+  uint64_t t_ps;                 // simulation time
+  uint8_t  level, cat;
+  uint16_t len;
+  char     text[116];            // truncated beyond this
+};
+
+namespace Log {
+  extern uint8_t threshold[LOGC_COUNT];   // runtime level per category
+
+  inline bool enabled(int level, int cat) { return level <= threshold[cat]; }
+  bool configure(const std::string& spec);              // false on a bad token
+  bool start(const std::string& path = "", bool with_time = false);  // "" = stdout, ".bin" = binary
+  void push(const LogRecord& r);
+  void flush();                  // block until every pushed record is written
+  void stop();                   // flush, join the drain thread, print drop/wait counts
+  const char* cat_tag(int cat);
+}
+
+// One record; the destructor commits it to the ring
+class LogLine : private std::streambuf, public std::ostream {
+public:
+  LogLine(int level, int cat);
+  ~LogLine() override;
+private:
+  LogRecord r_;                  // put area = r_.text; overflow truncates
+};
+
+#define ISP_LOG(level, cat, expr)                                          \
+  do {                                                                     \
+    if constexpr (log_compiled(level, cat)) {                              \
+      if (Log::enabled(level, cat)) { LogLine isp_log_line_(level, cat); isp_log_line_ << expr; } \
+    }                                                                      \
+  } while (0)
@@ -0,0 +1,102 @@
+#include "Lut1DTable.h"
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+
+static inline uint8_t clamp_u8(int v){ return (uint8_t)std::min(255, std::max(0, v)); }
+
+void Lut1DTable::load_identity() {
+  for (int i=0;i<256;++i) lut_[(size_t)i] = (uint8_t)i;
+}
+
+void Lut1DTable::apply_gain_offset(double g, double o) {
+  for (int i=0;i<256;++i) {
+    int v = (int)std::lround(g*i + o);
+    lut_[(size_t)i] = clamp_u8(v);
+  }
+}
+
+void Lut1DTable::apply_gamma(double gamma) {
+  if (gamma <= 0.0) return;
+  for (int i=0;i<256;++i) {
+    double n = i/255.0;
+    int v = (int)std::lround(std::pow(n, gamma) * 255.0);
+    lut_[(size_t)i] = clamp_u8(v);
+  }
+}
+
+bool Lut1DTable::load_lut_file(const std::string& path) {
+  std::ifstream f(path);
+  if (!f) return false;
+  std::array<int,256> tmp{};
+  int count = 0;
+
+  std::string line;
+  while (std::getline(f, line) && count < 256) {
+    if (line.empty()) continue;
+    std::stringstream ss(line);
+    if (line.find(',') != std::string::npos) {
+      int idx=-1,val=-1; char comma;
+      ss >> idx >> comma >> val;
+      if (!ss.fail() && val >= 0) tmp[count++] = val;
+    } else {
+      int val=-1; ss >> val;
+      if (!ss.fail() && val >= 0) tmp[count++] = val;
+    }
+  }
+  if (count != 256) return false;
+  for (int i=0;i<256;++i) lut_[(size_t)i] = clamp_u8(tmp[(size_t)i]);
+  return true;
+}
+
+bool Lut1DTable::dump_lut(const std::string& path) const {
+  std::ofstream f(path);
+  if (!f) return false;
+  for (int i=0;i<256;++i) f << (int)lut_[(size_t)i] << "\n";
+  return true;
+}
+
+// ---- Histogram stats ----
+void LutHistStats::reset() {
+  hist_in_.fill(0);
+  hist_out_.fill(0);
+  pix_index_ = 0;
+}
+
+void LutHistStats::end_frame() {
+  if (!en_) return;
+  if (!in_path_.empty())  (void)dump_in (in_path_);
+  if (!out_path_.empty()) (void)dump_out(out_path_);
+  // Typically you want per-frame histograms. Reset after dump:
+  reset();
+}
+
+void LutHistStats::save_state(SnapBuf& s) const {
+  s.u64(pix_index_);
+  s.raw(hist_in_.data(),  sizeof(hist_in_));
+  s.raw(hist_out_.data(), sizeof(hist_out_));
+}
+
+bool LutHistStats::restore_state(SnapCursor& c) {
+  pix_index_ = c.u64();
+  c.raw(hist_in_.data(),  sizeof(hist_in_));
+  c.raw(hist_out_.data(), sizeof(hist_out_));
+  return c.ok();
+}
+
+bool LutHistStats::dump_in(const std::string& path) const {
+  std::ofstream f(path);
+  if (!f) return false;
+  // CSV: value,count
+  for (int i=0;i<256;++i) f << i << "," << hist_in_[(size_t)i]  << "\n";
+  return true;
+}
+
+bool LutHistStats::dump_out(const std::string& path) const {
+  std::ofstream f(path);
+  if (!f) return false;
+  // CSV: value,count
+  for (int i=0;i<256;++i) f << i << "," << hist_out_[(size_t)i] << "\n";
+  return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <string>
+#include <cstdint>
+#include "Snapshot.h"
+
+// 256-entry post-ISP table with Lut1D_DE programming semantics (gain/offset
+// and gamma rebuild the table from the index; files hold 256 entries).
+// Shared by Lut1D_DE and the fused bypass path in CannyEdgeWrapper.
+struct Lut1DTable {
+  Lut1DTable() { load_identity(); }
+
+  uint8_t operator[](uint8_t x) const { return lut_[x]; }
+
+  void load_identity();
+  bool load_lut_file(const std::string& path);   // CSV (256 entries) or "idx,val"
+  void apply_gain_offset(double gain, double offset);
+  void apply_gamma(double gamma);
+  bool dump_lut(const std::string& path) const;
+
+  void save_state(SnapBuf& s) const { s.raw(lut_.data(), lut_.size()); }
+  bool restore_state(SnapCursor& c) { return c.raw(lut_.data(), lut_.size()); }
+
+private:
+  std::array<uint8_t,256> lut_{};
+};
+
+// Per-frame input/output histograms with optional auto-dump at frame end.
+struct LutHistStats {
+  void enable(bool en) { en_ = en; }
+  bool enabled() const { return en_; }
+  void reset();
+
+  void count(uint8_t in, uint8_t out) {
+    ++hist_in_[in];
+    ++hist_out_[out];
+    ++pix_index_;
+  }
+  void end_frame();   // auto-dump (if paths set) and reset
+
+  bool dump_in (const std::string& path) const;
+  bool dump_out(const std::string& path) const;
+  void set_in_dump_path (const std::string& path) { in_path_  = path; }
+  void set_out_dump_path(const std::string& path) { out_path_ = path; }
+
+  // Counts of the frame in progress (enable/dump paths are configuration)
+  void save_state(SnapBuf& s) const;
+  bool restore_state(SnapCursor& c);
+
+private:
+  bool en_ = false;
+  std::array<uint64_t,256> hist_in_{};
+  std::array<uint64_t,256> hist_out_{};
+  uint64_t pix_index_ = 0;
+  std::string in_path_;
+  std::string out_path_;
+};
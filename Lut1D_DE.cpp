@@ -1,10 +1,4 @@
 #include "Lut1D_DE.h"
-#include <fstream>
-#include <sstream>
-#include <cmath>
-#include <algorithm>
-
-static inline uint8_t clamp_u8(int v){ return (uint8_t)std::min(255, std::max(0, v)); }
 
 Lut1D_DE::Lut1D_DE(sc_core::sc_module_name name) : sc_module(name) {
   SC_METHOD(step);
@@ -15,6 +9,7 @@ Lut1D_DE::Lut1D_DE(sc_core::sc_module_name name) : sc_module(name) {
 void Lut1D_DE::step() {
   const bool vld = valid_in.read();
   const bool vs  = vsync_in.read();
+  if (perf_) pclk_.edge();
 
   // Pass through syncs
   vsync_out.write(vs);
@@ -25,101 +20,44 @@ void Lut1D_DE::step() {
     pix_out.write(y);
     valid_out.write(true);
 
-    if (stats_en_) {
-      ++hist_in_[x];
-      ++hist_out_[y];
-      ++pix_index_;
-    }
+    if (stats_.enabled()) stats_.count(x, y);
+    if (perf_ && pix_++ == 0) t_first_ = sc_core::sc_time_stamp();
+    if (energy_) ++energy_->c.lut_pix;
   } else {
     valid_out.write(false);
   }
 
   // On vsync rising edge: auto-dump and reset per-frame counters if paths set
   const bool vs_rise = (vs && !prev_vsync_);
-  if (vs_rise && stats_en_) {
-    if (!hist_in_path_.empty())  (void)dump_hist_in (hist_in_path_);
-    if (!hist_out_path_.empty()) (void)dump_hist_out(hist_out_path_);
-    // Typically you want per-frame histograms. Reset after dump:
-    reset_stats();
-  }
-  prev_vsync_ = vs;
-}
-
-void Lut1D_DE::load_identity() {
-  for (int i=0;i<256;++i) lut_[(size_t)i] = (uint8_t)i;
-}
-
-void Lut1D_DE::apply_gain_offset(double g, double o) {
-  for (int i=0;i<256;++i) {
-    int v = (int)std::lround(g*i + o);
-    lut_[(size_t)i] = clamp_u8(v);
-  }
-}
-
-void Lut1D_DE::apply_gamma(double gamma) {
-  if (gamma <= 0.0) return;
-  for (int i=0;i<256;++i) {
-    double n = i/255.0;
-    int v = (int)std::lround(std::pow(n, gamma) * 255.0);
-    lut_[(size_t)i] = clamp_u8(v);
-  }
-}
-
-bool Lut1D_DE::load_lut_file(const std::string& path) {
-  std::ifstream f(path);
-  if (!f) return false;
-  std::array<int,256> tmp{};
-  int count = 0;
-
-  std::string line;
-  while (std::getline(f, line) && count < 256) {
-    if (line.empty()) continue;
-    std::stringstream ss(line);
-    if (line.find(',') != std::string::npos) {
-      int idx=-1,val=-1; char comma;
-      ss >> idx >> comma >> val;
-      if (!ss.fail() && val >= 0) tmp[count++] = val;
-    } else {
-      int val=-1; ss >> val;
-      if (!ss.fail() && val >= 0) tmp[count++] = val;
+  if (vs_rise) {
+    stats_.end_frame();
+    if (perf_) {
+      // the last pixel leaves on the next edge
+      const sc_core::sc_time now = sc_core::sc_time_stamp();
+      const sc_core::sc_time lat = now + pclk_.period() - t_first_;
+      const double period_ns = have_vs_ ? (now - t_vs_).to_seconds() * 1e9 : 0.0;
+      perf_->record("lut", ++frame_, pclk_.cycles(pix_),
+                    { {"pixels", (double)pix_},
+                      {"latency_ns", lat.to_seconds() * 1e9},
+                      {"vsync_period_ns", period_ns} });
+      pix_ = 0; t_vs_ = now; have_vs_ = true;
     }
   }
-  if (count != 256) return false;
-  for (int i=0;i<256;++i) lut_[(size_t)i] = clamp_u8(tmp[(size_t)i]);
-  return true;
+  prev_vsync_ = vs;
 }
 
-bool Lut1D_DE::dump_lut(const std::string& path) const {
-  std::ofstream f(path);
-  if (!f) return false;
-  for (int i=0;i<256;++i) f << (int)lut_[(size_t)i] << "\n";
-  return true;
-}
+void Lut1D_DE::load_identity()                           { lut_.load_identity(); }
+void Lut1D_DE::apply_gain_offset(double g, double o)     { lut_.apply_gain_offset(g, o); }
+void Lut1D_DE::apply_gamma(double gamma)                 { lut_.apply_gamma(gamma); }
+bool Lut1D_DE::load_lut_file(const std::string& path)    { return lut_.load_lut_file(path); }
+bool Lut1D_DE::dump_lut(const std::string& path) const   { return lut_.dump_lut(path); }
 
 // ---- Stats controls ----
-void Lut1D_DE::enable_stats(bool en) { stats_en_ = en; }
-void Lut1D_DE::reset_stats() {
-  hist_in_.fill(0);
-  hist_out_.fill(0);
-  pix_index_ = 0;
-}
-
-bool Lut1D_DE::dump_hist_in (const std::string& path) const {
-  std::ofstream f(path);
-  if (!f) return false;
-  // CSV: value,count
-  for (int i=0;i<256;++i) f << i << "," << hist_in_[(size_t)i]  << "\n";
-  return true;
-}
-
-bool Lut1D_DE::dump_hist_out(const std::string& path) const {
-  std::ofstream f(path);
-  if (!f) return false;
-  // CSV: value,count
-  for (int i=0;i<256;++i) f << i << "," << hist_out_[(size_t)i] << "\n";
-  return true;
-}
+void Lut1D_DE::enable_stats(bool en) { stats_.enable(en); }
+void Lut1D_DE::reset_stats()         { stats_.reset(); }
 
-void Lut1D_DE::set_hist_in_dump_path (const std::string& path)  { hist_in_path_  = path; }
-void Lut1D_DE::set_hist_out_dump_path(const std::string& path)  { hist_out_path_ = path; }
+bool Lut1D_DE::dump_hist_in (const std::string& path) const { return stats_.dump_in(path); }
+bool Lut1D_DE::dump_hist_out(const std::string& path) const { return stats_.dump_out(path); }
 
+void Lut1D_DE::set_hist_in_dump_path (const std::string& path)  { stats_.set_in_dump_path(path); }
+void Lut1D_DE::set_hist_out_dump_path(const std::string& path)  { stats_.set_out_dump_path(path); }
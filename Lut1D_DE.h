@@ -3,6 +3,9 @@
 #include <array>
 #include <string>
 #include <cstdint>
+#include "Lut1DTable.h"
+#include "PerfCounters.h"
+#include "EnergyModel.h"
 
 // Post-ISP 1D LUT in DE domain: y = LUT[x] when valid_in is high.
 // Also collects histograms (per frame) of input and output values and can dump CSV on vsync.
@@ -27,6 +30,8 @@ struct Lut1D_DE : sc_core::sc_module {
   void apply_gain_offset(double gain, double offset);
   void apply_gamma(double gamma);
   bool dump_lut(const std::string& path) const;
+  void set_table(const Lut1DTable& t) { lut_ = t; }
+  const Lut1DTable& table() const { return lut_; }
 
   // Stats controls
   void enable_stats(bool en);
@@ -36,20 +41,30 @@ struct Lut1D_DE : sc_core::sc_module {
   void set_hist_in_dump_path (const std::string& path);   // auto-dump at each vsync if set
   void set_hist_out_dump_path(const std::string& path);   // auto-dump at each vsync if set
 
+  // Per-frame counters (latency, pixels, vsync period) at each vsync
+  void set_perf(PerfCounters* p) { perf_ = p; }
+  void set_energy(EnergyMeter* e) { energy_ = e; }   // per-pixel activity
+
+  // Snapshot: table + histograms of the frame in progress
+  void save_state(SnapBuf& s) const { lut_.save_state(s); stats_.save_state(s); }
+  bool restore_state(SnapCursor& c) { return lut_.restore_state(c) && stats_.restore_state(c); }
+
 private:
   // LUT
-  std::array<uint8_t,256> lut_{};
+  Lut1DTable lut_;
 
   // Stats
-  bool stats_en_ = false;
-  std::array<uint64_t,256> hist_in_{};
-  std::array<uint64_t,256> hist_out_{};
-  uint64_t pix_index_ = 0;
+  LutHistStats stats_;
   bool prev_vsync_ = false;
-  std::string hist_in_path_;
-  std::string hist_out_path_;
+
+  // Perf counters
+  PerfCounters*    perf_ = nullptr;
+  EnergyMeter*     energy_ = nullptr;
+  PerfClock        pclk_;
+  uint64_t         frame_ = 0, pix_ = 0;
+  sc_core::sc_time t_first_, t_vs_;
+  bool             have_vs_ = false;
 
   // Process
   void step();  // posedge clocked
 };
-
@@ -0,0 +1,16 @@
+#pragma once
+#include <vector>
+#include "CameraPipeline.h"
+#include "QosArbiter256.h"
+
+struct MultiCamOptions {
+  ArbPolicy policy         = ARB_ROUND_ROBIN;
+  unsigned  issue_interval = 1;     // arbiter issues one beat every N cycles
+  unsigned  queue_depth    = 4;     // per-port input queue (beats)
+  unsigned  starve_cycles  = 256;   // latency above this counts as starvation
+};
+
+// Elaborates N CameraPipeline instances sharing one LPDDR through a
+// QosArbiter256, runs the simulation and writes out_cam<k>.pgm.
+// Called from sc_main when one or more --cam= options are given.
+int run_multicam(const std::vector<CameraConfig>& cams, const MultiCamOptions& opt);
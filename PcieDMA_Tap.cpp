@@ -1,4 +1,5 @@
 #include "PcieDMA_Tap.h"
+#include "Log.h"
 using sc_core::sc_time_stamp;
 
 PcieDMA_Tap::PcieDMA_Tap(sc_core::sc_module_name name) : sc_module(name) {
@@ -15,12 +16,14 @@ void PcieDMA_Tap::run() {
     if (valid_in.read()) {
       if (!started_) { started_ = true; t0_ = sc_time_stamp(); }
       seen_ += 32; // 256 bits per beat
-      if (!printed_ && expected_ && seen_ >= expected_) {
+      const bool last = last_in.read();
+      if (!printed_ && ((expected_ && seen_ >= expected_) || last)) {
         t1_ = sc_time_stamp();
+        const uint64_t bytes = (expected_ && seen_ >= expected_) ? expected_ : seen_;
         double gbps = 0.0;
         auto dt = t1_ - t0_;
-        if (dt.value() > 0) gbps = (double)expected_ / (dt.to_seconds() * 1e9);
-        std::cout << "[PCIEDMA] bytes=" << expected_ << " throughput=" << gbps << " GB/s\n";
+        if (dt.value() > 0) gbps = (double)bytes / (dt.to_seconds() * 1e9);
+        ISP_LOG(LOG_INFO, LOGC_DMA, "bytes=" << bytes << " throughput=" << gbps << " GB/s");
         printed_ = true;
       }
     }
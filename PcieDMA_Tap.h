@@ -7,6 +7,7 @@ struct PcieDMA_Tap : sc_core::sc_module {
   sc_core::sc_in<bool>                clk;
   sc_core::sc_in< sc_dt::sc_bv<256> > data_in;
   sc_core::sc_in<bool>                valid_in;
+  sc_core::sc_in<bool>                last_in;   // frame end when the size is not known up front
 
   SC_HAS_PROCESS(PcieDMA_Tap);
   PcieDMA_Tap(sc_core::sc_module_name name);
@@ -0,0 +1,57 @@
+#include "PerfCounters.h"
+#include <iomanip>
+#include <iostream>
+
+static inline double to_ns(const sc_core::sc_time& t) { return t.to_seconds() * 1e9; }
+
+bool PerfCounters::open(const std::string& path) {
+  csv_ = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+  out_.open(path);
+  if (!out_) return false;
+  if (csv_) out_ << "t_ns,stage,frame,busy_ns,counter,value\n";
+  return true;
+}
+
+void PerfCounters::record(const std::string& stage, uint64_t frame, const sc_core::sc_time& busy,
+                          const std::vector<PerfField>& fields) {
+  const double t_ns    = to_ns(sc_core::sc_time_stamp());
+  const double busy_ns = to_ns(busy);
+
+  StageTotals& st = totals_[stage];
+  if (st.frames == 0) order_.push_back(stage);
+  ++st.frames;
+  st.busy_sum_ns += busy_ns;
+  if (busy_ns > st.busy_max_ns) st.busy_max_ns = busy_ns;
+
+  if (!out_) return;
+  if (csv_) {
+    out_ << t_ns << "," << stage << "," << frame << "," << busy_ns << ",busy_ns," << busy_ns << "\n";
+    for (const PerfField& f : fields)
+      out_ << t_ns << "," << stage << "," << frame << "," << busy_ns << "," << f.key << "," << f.value << "\n";
+  } else {
+    out_ << "{\"t_ns\":" << t_ns << ",\"stage\":\"" << stage << "\",\"frame\":" << frame
+         << ",\"busy_ns\":" << busy_ns;
+    for (const PerfField& f : fields) out_ << ",\"" << f.key << "\":" << f.value;
+    out_ << "}\n";
+  }
+  out_.flush();
+}
+
+void PerfCounters::summary() const {
+  if (order_.empty()) return;
+  std::string worst;
+  double worst_ns = -1.0;
+  for (const std::string& s : order_) {
+    const StageTotals& st = totals_.at(s);
+    const double avg = st.busy_sum_ns / (double)st.frames;
+    std::cout << "[PERF] " << std::left << std::setw(10) << s << std::right
+              << " frames=" << st.frames << " busy_avg=" << avg << " ns"
+              << " busy_max=" << st.busy_max_ns << " ns";
+    if (avg > 0) std::cout << " fps_bound=" << 1e9 / avg;
+    std::cout << "\n";
+    if (avg > worst_ns) { worst_ns = avg; worst = s; }
+  }
+  std::cout << "[PERF] bottleneck: " << worst;
+  if (worst_ns > 0) std::cout << " (" << worst_ns << " ns/frame, max " << 1e9 / worst_ns << " fps)";
+  std::cout << "\n";
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <systemc>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Simulated hardware performance counters. DE modules that were given a
+// PerfCounters* (set_perf) append one record per frame: the time the stage
+// was occupied by that frame ("busy") plus stage-specific counters. Records
+// go to a JSON-lines file, or CSV when the path ends in ".csv". summary()
+// names the stage with the largest busy time per frame, i.e. the one that
+// bounds the sustainable frame rate.
+struct PerfField {
+  const char* key;
+  double      value;
+};
+
+class PerfCounters {
+public:
+  bool open(const std::string& path);
+  bool enabled() const { return out_.is_open(); }
+
+  void record(const std::string& stage, uint64_t frame, const sc_core::sc_time& busy,
+              const std::vector<PerfField>& fields);
+  void summary() const;
+
+private:
+  struct StageTotals {
+    uint64_t frames = 0;
+    double   busy_sum_ns = 0.0, busy_max_ns = 0.0;
+  };
+  std::ofstream out_;
+  bool csv_ = false;
+  std::vector<std::string> order_;               // stages in first-seen order
+  std::map<std::string, StageTotals> totals_;
+};
+
+// Clock period as seen by a clocked process (time between its activations).
+struct PerfClock {
+  void edge() {
+    const sc_core::sc_time now = sc_core::sc_time_stamp();
+    if (seen_ && now > last_) period_ = now - last_;
+    last_ = now; seen_ = true;
+  }
+  const sc_core::sc_time& period() const { return period_; }
+  sc_core::sc_time cycles(uint64_t n) const { return period_ * (double)n; }
+
+private:
+  sc_core::sc_time last_, period_;
+  bool seen_ = false;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Bit toggles between two 256-bit words: popcount(a ^ b) over 4x64 bits.
+// AVX-512 VPOPCNTQ when available, else the AVX2 nibble-LUT (vpshufb +
+// vpsadbw) popcount, else four scalar popcounts.
+static inline uint64_t toggles256(const uint64_t* a, const uint64_t* b) {
+#if defined(__AVX512VPOPCNTDQ__) && defined(__AVX512VL__)
+  const __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)a),
+                                     _mm256_loadu_si256((const __m256i*)b));
+  const __m256i c = _mm256_popcnt_epi64(x);
+  const __m128i s = _mm_add_epi64(_mm256_castsi256_si128(c), _mm256_extracti128_si256(c, 1));
+  return (uint64_t)_mm_cvtsi128_si64(s) + (uint64_t)_mm_extract_epi64(s, 1);
+#elif defined(__AVX2__)
+  const __m256i lut  = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                        0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+  const __m256i low4 = _mm256_set1_epi8(0x0f);
+  const __m256i x  = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)a),
+                                      _mm256_loadu_si256((const __m256i*)b));
+  const __m256i lo = _mm256_and_si256(x, low4);
+  const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), low4);
+  const __m256i n  = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+  const __m256i c  = _mm256_sad_epu8(n, _mm256_setzero_si256());   // 4x u64 partial sums
+  const __m128i s  = _mm_add_epi64(_mm256_castsi256_si128(c), _mm256_extracti128_si256(c, 1));
+  return (uint64_t)_mm_cvtsi128_si64(s) + (uint64_t)_mm_extract_epi64(s, 1);
+#else
+  return (uint64_t)(__builtin_popcountll(a[0] ^ b[0]) + __builtin_popcountll(a[1] ^ b[1]) +
+                    __builtin_popcountll(a[2] ^ b[2]) + __builtin_popcountll(a[3] ^ b[3]));
+#endif
+}
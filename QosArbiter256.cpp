@@ -0,0 +1,155 @@
+#include "QosArbiter256.h"
+#include <algorithm>
+#include <iostream>
+using sc_core::sc_time_stamp;
+
+bool parse_arb_policy(const std::string& s, ArbPolicy& p) {
+  if (s == "rr" || s == "round-robin")           { p = ARB_ROUND_ROBIN;     return true; }
+  if (s == "wrr" || s == "weighted")             { p = ARB_WEIGHTED;        return true; }
+  if (s == "prio" || s == "strict" || s == "priority") { p = ARB_STRICT_PRIORITY; return true; }
+  return false;
+}
+
+const char* arb_policy_name(ArbPolicy p) {
+  switch (p) {
+    case ARB_WEIGHTED:        return "weighted";
+    case ARB_STRICT_PRIORITY: return "strict-priority";
+    default:                  return "round-robin";
+  }
+}
+
+QosArbiter256::QosArbiter256(sc_core::sc_module_name name, unsigned ports, unsigned queue_depth)
+: sc_module(name),
+  clk("clk"),
+  in_data("in_data", ports),
+  in_valid("in_valid", ports),
+  in_last("in_last", ports),
+  in_ready("in_ready", ports),
+  out_data("out_data"),
+  out_valid("out_valid"),
+  out_last("out_last"),
+  out_id("out_id"),
+  out_ready("out_ready"),
+  n_(ports), depth_(std::max(2u, queue_depth)), ports_(ports)
+{
+  SC_METHOD(step);
+  sensitive << clk.pos();
+  dont_initialize();
+}
+
+void QosArbiter256::set_weight(unsigned port, unsigned w) {
+  if (port < n_) { ports_[port].weight = w ? w : 1; ports_[port].credit = ports_[port].weight; }
+}
+
+void QosArbiter256::set_priority(unsigned port, unsigned prio) {
+  if (port < n_) ports_[port].prio = prio;
+}
+
+int QosArbiter256::pick() {
+  switch (policy_) {
+    case ARB_STRICT_PRIORITY: {
+      int best = -1;
+      for (unsigned k=0; k<n_; ++k) {
+        const unsigned i = (rr_ptr_ + k) % n_;   // RR among equal priorities
+        if (ports_[i].q.empty()) continue;
+        if (best < 0 || ports_[i].prio < ports_[(unsigned)best].prio) best = (int)i;
+      }
+      return best;
+    }
+    case ARB_WEIGHTED: {
+      // Credit-based WRR: refill once every requester has spent its credits
+      for (int pass=0; pass<2; ++pass) {
+        for (unsigned k=0; k<n_; ++k) {
+          const unsigned i = (rr_ptr_ + k) % n_;
+          if (!ports_[i].q.empty() && ports_[i].credit) return (int)i;
+        }
+        for (auto& p : ports_) p.credit = p.weight;
+      }
+      return -1;
+    }
+    default:
+      for (unsigned k=0; k<n_; ++k) {
+        const unsigned i = (rr_ptr_ + k) % n_;
+        if (!ports_[i].q.empty()) return (int)i;
+      }
+      return -1;
+  }
+}
+
+void QosArbiter256::step() {
+  ++cycle_;
+
+  // ---- Input side: accept beats presented against our ready ----
+  for (unsigned i=0; i<n_; ++i) {
+    Port& p = ports_[i];
+    if (in_valid[i].read()) {
+      if (p.rdy_q2) {
+        // the source saw ready, so the beat is gone either way; a full
+        // queue here means the source ignored the skid margin
+        if (p.q.size() < depth_) p.q.push_back(Beat{in_data[i].read(), in_last[i].read(), cycle_});
+        else ++p.overflow;
+      } else {
+        ++p.stall_cycles;   // source is holding a beat against backpressure
+      }
+    }
+  }
+
+  // ---- Issue one beat per interval ----
+  bool sent = false;
+  if (out_ready.read() && cycle_ - last_issue_ >= interval_) {
+    const int g = pick();
+    if (g >= 0) {
+      Port& p = ports_[(unsigned)g];
+      const Beat b = p.q.front();
+      p.q.pop_front();
+      out_data.write(b.data);
+      out_last.write(b.last);
+      out_id.write((unsigned)g);
+      out_valid.write(true);
+      sent = true;
+
+      const uint64_t lat = cycle_ - b.t_in;
+      if (!p.beats) p.t_first = sc_time_stamp();
+      p.t_last = sc_time_stamp();
+      ++p.beats;
+      p.lat_sum += lat;
+      p.lat_max  = std::max(p.lat_max, lat);
+      if (lat > starve_thr_) ++p.starved;
+      if (policy_ == ARB_WEIGHTED && p.credit) --p.credit;
+      rr_ptr_     = ((unsigned)g + 1) % n_;
+      last_issue_ = cycle_;
+      ++issued_;
+    }
+  }
+  if (!sent) { out_valid.write(false); out_last.write(false); }
+
+  // ---- Ready with a two-slot skid margin (beats arrive two edges later) ----
+  for (unsigned i=0; i<n_; ++i) {
+    Port& p = ports_[i];
+    const bool rdy = p.q.size() + 1 < depth_;
+    in_ready[i].write(rdy);
+    p.rdy_q2 = p.rdy_q1;
+    p.rdy_q1 = rdy;
+  }
+}
+
+void QosArbiter256::report() const {
+  std::cout << "[ARB] policy=" << arb_policy_name(policy_) << " ports=" << n_
+            << " issue_interval=" << interval_ << " beats=" << issued_
+            << " util=" << (cycle_ ? 100.0 * (double)issued_ * interval_ / (double)cycle_ : 0.0) << "%\n";
+  for (unsigned i=0; i<n_; ++i) {
+    const Port& p = ports_[i];
+    double gbps = 0.0;
+    const auto dt = p.t_last - p.t_first;
+    if (p.beats > 1 && dt.value() > 0) gbps = (double)(p.beats * 32) / (dt.to_seconds() * 1e9);
+    std::cout << "[ARB] cam" << i << " beats=" << p.beats << " bytes=" << p.beats * 32
+              << " bw=" << gbps << " GB/s"
+              << " lat_avg=" << (p.beats ? (double)p.lat_sum / (double)p.beats : 0.0)
+              << " lat_max=" << p.lat_max << " cyc"
+              << " starved=" << p.starved << " (>" << starve_thr_ << " cyc)"
+              << " src_stall=" << p.stall_cycles << " cyc\n";
+    if (p.overflow)
+      std::cout << "[ARB] cam" << i << " WARNING: " << p.overflow
+                << " beats lost to input queue overflow (depth=" << depth_ << ")\n";
+  }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <systemc>
+#include <deque>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+enum ArbPolicy { ARB_ROUND_ROBIN = 0, ARB_WEIGHTED = 1, ARB_STRICT_PRIORITY = 2 };
+
+bool        parse_arb_policy(const std::string& s, ArbPolicy& p);
+const char* arb_policy_name(ArbPolicy p);
+
+// N x 256-bit write ports -> one LPDDR write port.
+// Each port has a small input queue (ready drops with a two-slot skid margin,
+// same handshake as AsyncFifo). One beat is issued every 'issue_interval'
+// cycles, chosen by round-robin, weighted round-robin (credits = weight) or
+// strict priority (lower value wins). out_id tags the beat with its port so
+// LPDDR can keep one region per camera.
+struct QosArbiter256 : sc_core::sc_module {
+  sc_core::sc_in<bool> clk;
+
+  sc_core::sc_vector< sc_core::sc_in< sc_dt::sc_bv<256> > > in_data;
+  sc_core::sc_vector< sc_core::sc_in<bool> >                in_valid;
+  sc_core::sc_vector< sc_core::sc_in<bool> >                in_last;
+  sc_core::sc_vector< sc_core::sc_out<bool> >               in_ready;
+
+  sc_core::sc_out< sc_dt::sc_bv<256> > out_data;
+  sc_core::sc_out<bool>                out_valid;
+  sc_core::sc_out<bool>                out_last;
+  sc_core::sc_out< sc_dt::sc_uint<8> > out_id;
+  sc_core::sc_in<bool>                 out_ready;
+
+  SC_HAS_PROCESS(QosArbiter256);
+  QosArbiter256(sc_core::sc_module_name name, unsigned ports, unsigned queue_depth = 4);
+
+  void set_policy(ArbPolicy p) { policy_ = p; }
+  void set_weight  (unsigned port, unsigned w);
+  void set_priority(unsigned port, unsigned prio);
+  void set_issue_interval(unsigned cycles) { interval_ = cycles ? cycles : 1; }
+  void set_starve_threshold(unsigned cycles) { starve_thr_ = cycles; }
+
+  void report() const;
+
+private:
+  struct Beat { sc_dt::sc_bv<256> data; bool last; uint64_t t_in; };
+  struct Port {
+    std::deque<Beat> q;
+    bool     rdy_q1 = false, rdy_q2 = false;   // ready driven 1 and 2 edges ago
+    unsigned weight = 1, credit = 1, prio = 0;
+    // stats
+    uint64_t beats = 0, lat_sum = 0, lat_max = 0;
+    uint64_t starved = 0, stall_cycles = 0;
+    uint64_t overflow = 0;                     // beats taken with the queue full
+    sc_core::sc_time t_first, t_last;
+  };
+
+  const unsigned   n_;
+  const unsigned   depth_;
+  std::vector<Port> ports_;
+  ArbPolicy policy_     = ARB_ROUND_ROBIN;
+  unsigned  interval_   = 1;
+  unsigned  starve_thr_ = 256;
+  unsigned  rr_ptr_     = 0;
+  uint64_t  cycle_      = 0;
+  uint64_t  last_issue_ = 0;
+  uint64_t  issued_     = 0;
+
+  void step();     // posedge clocked
+  int  pick();     // -1 if nothing eligible
+};
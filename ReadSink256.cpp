@@ -1,4 +1,5 @@
 #include "ReadSink256.h"
+#include "Log.h"
 using sc_core::sc_time_stamp;
 
 ReadSink256::ReadSink256(sc_core::sc_module_name name) : sc_module(name) {
@@ -21,7 +22,7 @@ void ReadSink256::run() {
         double gbps = 0.0;
         auto dt = t1_ - t0_;
         if (dt.value() > 0) gbps = (double)expected_ / (dt.to_seconds() * 1e9);
-        std::cout << "[READSINK] bytes=" << expected_ << " throughput=" << gbps << " GB/s\n";
+        ISP_LOG(LOG_INFO, LOGC_READ, "bytes=" << expected_ << " throughput=" << gbps << " GB/s");
         printed_ = true;
       }
     }
@@ -1,22 +1,23 @@
 #include "Sensor.h"
-#include <cstdio>
+#include "Log.h"
 
-cmos_sensor::cmos_sensor(sc_core::sc_module_name nm, const std::vector<uint8_t>& img)
-: sca_tdf::sca_module(nm), out("out"), image_(img) {
-    std::printf("[SENSOR] Loaded %zu pixels from host image.\n", image_.size());
+cmos_sensor::cmos_sensor(sc_core::sc_module_name nm, const std::vector<uint8_t>& img,
+                         sc_core::sc_time Ts)
+: sca_tdf::sca_module(nm), out("out"), image_(img), Ts_(Ts) {
+    ro_.configure(ReadoutMode(), (int)image_.size(), 1);
+    ISP_LOG(LOG_INFO, LOGC_SENSOR, "Loaded " << image_.size() << " pixels from host image.");
 }
 
 void cmos_sensor::set_attributes() {
-    out.set_timestep(sc_core::sc_time(10, sc_core::SC_NS));
+    out.set_timestep(Ts_);
 }
 
 void cmos_sensor::processing() {
-    if (idx_ >= image_.size()) {
+    if (idx_ >= ro_.samples()) {
         out.write(0.0);
         return;
     }
-    const double v = static_cast<double>(image_[idx_]);
-    out.write(v);
+    out.write(ro_.sample(image_, idx_));
     ++idx_;
 }
 
@@ -2,17 +2,24 @@
 #include <systemc-ams.h>
 #include <vector>
 #include <cstdint>
+#include "SensorReadout.h"
 
 struct cmos_sensor : sca_tdf::sca_module {
     sca_tdf::sca_out<double> out;
 
-    cmos_sensor(sc_core::sc_module_name nm, const std::vector<uint8_t>& img);
+    cmos_sensor(sc_core::sc_module_name nm, const std::vector<uint8_t>& img,
+                sc_core::sc_time Ts = sc_core::sc_time(10, sc_core::SC_NS));
+
+    // Readout mode (ROI / skip / bin) on the full array; default reads every pixel
+    void set_readout(const SensorReadout& r) { ro_ = r; }
 
     void set_attributes() override;
     void processing() override;
 
 private:
     std::vector<uint8_t> image_;
+    SensorReadout        ro_;
+    sc_core::sc_time     Ts_;      // one pixel per sensor/ISP clock period
     std::size_t idx_ = 0;
 };
 
@@ -0,0 +1,170 @@
+#include "SensorFifo_DE.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include "Log.h"
+
+bool parse_sensor_fifo_spec(const std::string& spec, SensorFifoConfig& cfg) {
+  std::stringstream ss(spec);
+  std::string kv;
+  while (std::getline(ss, kv, ',')) {
+    if (kv.empty()) continue;
+    const size_t eq = kv.find('=');
+    const std::string k = kv.substr(0, eq);
+    const std::string v = (eq == std::string::npos) ? "" : kv.substr(eq + 1);
+    bool ok = true;
+    if (k == "depth") {
+      cfg.depth = (unsigned)std::stoul(v);
+      ok = cfg.depth > 0;
+    }
+    else if (k == "mode") {
+      if      (v == "pixel") cfg.line_mode = false;
+      else if (v == "line")  cfg.line_mode = true;
+      else ok = false;
+    }
+    else if (k == "drop") {
+      if      (v == "pixel") cfg.frame_drop = false;
+      else if (v == "frame") cfg.frame_drop = true;
+      else ok = false;
+    }
+    else {
+      std::cerr << "[WARN] Unknown sensor-fifo key '" << k << "'\n";
+      return false;
+    }
+    if (!ok) {
+      std::cerr << "[WARN] Bad sensor-fifo value '" << kv << "'\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+SensorFifo_DE::SensorFifo_DE(sc_core::sc_module_name name, int W, int H, const SensorFifoConfig& cfg)
+: sc_module(name), W_(W), H_(H), cfg_(cfg),
+  buf_(cfg.line_mode ? (size_t)cfg.depth * W : (size_t)cfg.depth)
+{
+  SC_METHOD(step);
+  sensitive << clk.pos();
+  dont_initialize();
+}
+
+void SensorFifo_DE::step() {
+  // Head taken at this edge?
+  const bool ready = ready_in.size() == 0 || ready_in->read();
+  if (out_valid_ && ready) {
+    if (count_ == queued_) { --queued_; sent_ = true; }   // from the frame coming in
+    head_ = (head_ + 1) % buf_.size();
+    --count_;
+  } else if (out_valid_) {
+    ++stall_;
+  }
+
+  if (valid_in.read()) accept((uint8_t)pix_in.read().to_uint(), vsync_in.read());
+
+  out_valid_ = count_ > 0;
+  if (out_valid_) {
+    pix_out.write(buf_[head_].pix);
+    vsync_out.write(buf_[head_].vs);
+  } else {
+    vsync_out.write(false);
+  }
+  valid_out.write(out_valid_);
+}
+
+void SensorFifo_DE::accept(uint8_t pix, bool vs) {
+  // mode=line: a row is admitted whole or not at all
+  if (col_ == 0 && cfg_.line_mode && !cut_) {
+    line_ok_ = buf_.size() - count_ >= (size_t)W_;
+    if (!line_ok_ && cfg_.frame_drop) { ++cur_.overflow; drop_frame(); }
+  }
+
+  if (cut_) {
+    lose(vs);
+  } else if (!line_ok_ && !(vs && count_ < buf_.size())) {
+    // a refused row still delivers the frame's vsync pixel when it fits:
+    // the FIFO may have drained, leaving no queued pixel to carry it
+    ++cur_.overflow;
+    lose(vs);
+  } else if (count_ == buf_.size()) {
+    ++cur_.overflow;
+    if (cfg_.frame_drop) drop_frame();
+    lose(vs);
+  } else {
+    buf_[(head_ + count_) % buf_.size()] = Entry{ pix, vs };
+    ++count_; ++queued_;
+    cur_.peak = std::max(cur_.peak, count_);
+  }
+
+  if (++col_ == (unsigned)W_) end_line();
+  if (vs) end_frame();
+}
+
+void SensorFifo_DE::lose(bool vs) {
+  ++cur_.dropped_px;
+  line_hit_ = true;
+  // keep the frame delimited: vsync moves to its last queued pixel
+  if (vs && queued_ > 0) tail().vs = true;
+}
+
+void SensorFifo_DE::drop_frame() {
+  if (!sent_) {
+    // nothing has left yet: purge the frame from the tail
+    cur_.dropped_px += queued_;
+    count_ -= queued_;
+    queued_ = 0;
+  } else {
+    tail().vs = true;        // queued_ > 0: the FIFO holds only this frame
+  }
+  cut_ = true;
+}
+
+void SensorFifo_DE::end_line() {
+  if (line_hit_) ++cur_.dropped_lines;
+  col_ = 0;
+  line_hit_ = false;
+  line_ok_  = true;
+}
+
+void SensorFifo_DE::end_frame() {
+  if (col_ != 0) end_line();
+  ++frames_;
+  const bool purged = cut_ && !sent_;
+  if (purged) { ++purged_; cur_.dropped_lines = (uint64_t)H_; }
+  else if (cut_) ++cut_frames_;
+
+  if (cur_.dropped_px == 0) {
+    ++clean_;
+    clean_peak_ = std::max(clean_peak_, cur_.peak);
+    ISP_LOG(LOG_DEBUG, LOGC_SENSOR, "[SFIFO] frame " << frames_ << " peak=" << cur_.peak << "/" << buf_.size());
+  } else {
+    ISP_LOG(LOG_WARN, LOGC_SENSOR, "[SFIFO] frame " << frames_
+            << (purged ? " dropped" : cut_ ? " cut" : " damaged")
+            << " overflow=" << cur_.overflow << " lost_px=" << cur_.dropped_px
+            << " lost_lines=" << cur_.dropped_lines);
+  }
+
+  tot_.overflow      += cur_.overflow;
+  tot_.dropped_px    += cur_.dropped_px;
+  tot_.dropped_lines += cur_.dropped_lines;
+  tot_.peak = std::max(tot_.peak, cur_.peak);
+  cur_ = FrameCount();
+  queued_ = 0;
+  sent_ = cut_ = false;
+}
+
+void SensorFifo_DE::report() const {
+  std::cout << "[SFIFO] depth=" << cfg_.depth << (cfg_.line_mode ? " lines (" : " px (")
+            << buf_.size() << " px) drop=" << (cfg_.frame_drop ? "frame" : "pixel")
+            << " frames=" << frames_ << " clean=" << clean_ << " cut=" << cut_frames_
+            << " dropped=" << purged_ << " lost_px=" << tot_.dropped_px
+            << " lost_lines=" << tot_.dropped_lines << " overflow=" << tot_.overflow
+            << " stall_cycles=" << stall_ << " peak=" << tot_.peak << "\n";
+  if (frames_ == 0) return;
+  if (clean_ == frames_)
+    std::cout << "[SFIFO] No loss; peak occupancy " << tot_.peak
+              << " px is the buffering this run needs\n";
+  else
+    std::cout << "[SFIFO] Overflow in " << (frames_ - clean_) << "/" << frames_
+              << " frames; peak over clean frames " << clean_peak_
+              << " px, use a deeper FIFO or a faster consumer\n";
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <systemc>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Elastic FIFO after the ADC. CLI form:
+//   --sensor-fifo=depth=64,mode=pixel|line,drop=pixel|frame
+struct SensorFifoConfig {
+  unsigned depth      = 64;      // pixels, or lines of W pixels with mode=line
+  bool     line_mode  = false;   // admit a row only if the whole row fits
+  bool     frame_drop = false;   // on overflow drop (or cut) the frame, not pixels
+};
+
+bool parse_sensor_fifo_spec(const std::string& spec, SensorFifoConfig& cfg);
+
+// The sensor cannot stall, so the input side takes a pixel every valid cycle
+// and the FIFO absorbs consumer backpressure. A pixel leaves at an edge where
+// valid_out && ready_in. On overflow:
+//   drop=pixel  the pixel is lost (mode=line: the whole row is refused at its
+//               first pixel, except a vsync pixel that fits); a lost vsync
+//               moves to the last queued pixel
+//   drop=frame  a frame none of which has left is purged entirely; one that
+//               has started leaving is cut, with vsync moved onto its last
+//               queued pixel, so the elastic ISP can discard the short frame
+// Overflow, lost pixels and damaged rows are counted per frame.
+struct SensorFifo_DE : sc_core::sc_module {
+  sc_core::sc_in<bool>                clk;
+
+  sc_core::sc_in< sc_dt::sc_uint<8> > pix_in;
+  sc_core::sc_in<bool>                valid_in;
+  sc_core::sc_in<bool>                vsync_in;
+
+  sc_core::sc_out< sc_dt::sc_uint<8> > pix_out;
+  sc_core::sc_out<bool>                 valid_out;
+  sc_core::sc_out<bool>                 vsync_out;
+  // Consumer ready; unbound means a consumer without backpressure
+  sc_core::sc_port< sc_core::sc_signal_in_if<bool>, 1, sc_core::SC_ZERO_OR_MORE_BOUND > ready_in;
+
+  SC_HAS_PROCESS(SensorFifo_DE);
+  SensorFifo_DE(sc_core::sc_module_name name, int W, int H, const SensorFifoConfig& cfg);
+
+  unsigned capacity() const { return (unsigned)buf_.size(); }
+  uint64_t lost_pixels() const { return tot_.dropped_px; }
+  void report() const;
+
+private:
+  struct Entry { uint8_t pix; bool vs; };
+  struct FrameCount {
+    uint64_t overflow = 0, dropped_px = 0, dropped_lines = 0;
+    unsigned peak = 0;
+  };
+
+  const int W_, H_;
+  const SensorFifoConfig cfg_;
+
+  // Ring storage
+  std::vector<Entry> buf_;
+  unsigned head_ = 0, count_ = 0;
+  bool     out_valid_ = false;            // head presented this cycle
+
+  // Input frame in progress
+  unsigned col_ = 0;
+  unsigned queued_ = 0;                   // its pixels still in the FIFO (at the tail)
+  bool     sent_ = false;                 // some of it has left
+  bool     cut_ = false;                  // drop=frame: rest of the frame discarded
+  bool     line_ok_ = true, line_hit_ = false;
+  FrameCount cur_;
+
+  // Totals
+  FrameCount tot_;
+  uint64_t frames_ = 0, clean_ = 0, cut_frames_ = 0, purged_ = 0, stall_ = 0;
+  unsigned clean_peak_ = 0;               // max occupancy over loss-free frames
+
+  void step();
+  void accept(uint8_t pix, bool vs);
+  void lose(bool vs);
+  void drop_frame();
+  void end_line();
+  void end_frame();
+  Entry& tail() { return buf_[(head_ + count_ - 1) % buf_.size()]; }
+};
@@ -0,0 +1,74 @@
+#include "SensorReadout.h"
+#include <iostream>
+#include <sstream>
+
+static bool parse_pair(const std::string& v, int& a, int& b) {
+  const size_t x = v.find('x');
+  if (x == std::string::npos) { a = b = std::stoi(v); return a > 0; }
+  a = std::stoi(v.substr(0, x));
+  b = std::stoi(v.substr(x + 1));
+  return a > 0 && b > 0;
+}
+
+bool parse_readout_spec(const std::string& spec, ReadoutMode& m) {
+  std::stringstream ss(spec);
+  std::string kv;
+  while (std::getline(ss, kv, ',')) {
+    if (kv.empty()) continue;
+    const size_t eq = kv.find('=');
+    const std::string k = kv.substr(0, eq);
+    const std::string v = (eq == std::string::npos) ? "" : kv.substr(eq + 1);
+    bool ok = true;
+    if (k == "roi") {
+      // <w>x<h>+<x>+<y>
+      const size_t p1 = v.find('+');
+      ok = parse_pair(v.substr(0, p1), m.roi_w, m.roi_h);
+      if (ok && p1 != std::string::npos) {
+        const size_t p2 = v.find('+', p1 + 1);
+        m.roi_x = std::stoi(v.substr(p1 + 1, p2 - p1 - 1));
+        m.roi_y = (p2 == std::string::npos) ? 0 : std::stoi(v.substr(p2 + 1));
+      }
+    }
+    else if (k == "bin")  ok = parse_pair(v, m.bin_x, m.bin_y);
+    else if (k == "skip") ok = parse_pair(v, m.skip_x, m.skip_y);
+    else {
+      std::cerr << "[WARN] Unknown readout key '" << k << "'\n";
+      return false;
+    }
+    if (!ok) {
+      std::cerr << "[WARN] Bad readout value '" << kv << "'\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SensorReadout::configure(const ReadoutMode& m, int W, int H) {
+  m_ = m;
+  W_ = W; H_ = H;
+  if (m_.roi_w == 0) { m_.roi_x = 0; m_.roi_w = W; }
+  if (m_.roi_h == 0) { m_.roi_y = 0; m_.roi_h = H; }
+  if (m_.roi_x < 0 || m_.roi_y < 0 || m_.roi_x + m_.roi_w > W || m_.roi_y + m_.roi_h > H)
+    return false;
+  // pixels kept after skipping, then whole bins only
+  const int kw = (m_.roi_w + m_.skip_x - 1) / m_.skip_x;
+  const int kh = (m_.roi_h + m_.skip_y - 1) / m_.skip_y;
+  ow_ = kw / m_.bin_x;
+  oh_ = kh / m_.bin_y;
+  return ow_ > 0 && oh_ > 0;
+}
+
+double SensorReadout::sample(const std::vector<uint8_t>& img, size_t n) const {
+  const int oy = (int)(n / (size_t)ow_), ox = (int)(n % (size_t)ow_);
+  if (m_.bin_x == 1 && m_.bin_y == 1) {
+    const int x = m_.roi_x + ox * m_.skip_x, y = m_.roi_y + oy * m_.skip_y;
+    return (double)img[(size_t)y * W_ + x];
+  }
+  double acc = 0.0;
+  for (int by = 0; by < m_.bin_y; ++by) {
+    const int y = m_.roi_y + (oy * m_.bin_y + by) * m_.skip_y;
+    for (int bx = 0; bx < m_.bin_x; ++bx)
+      acc += (double)img[(size_t)y * W_ + m_.roi_x + (ox * m_.bin_x + bx) * m_.skip_x];
+  }
+  return acc / (double)(m_.bin_x * m_.bin_y);
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Sensor readout mode. CLI form (comma separated, any subset):
+//   --readout=roi=<w>x<h>+<x>+<y>,bin=<bx>x<by>,skip=<sx>x<sy>
+// The ROI window is cut from the full array, skipping keeps every sx-th
+// column / sy-th row of it, and binning averages bx*by of the remaining
+// pixels (charge/voltage domain, before the ADC).
+struct ReadoutMode {
+  int roi_x = 0, roi_y = 0, roi_w = 0, roi_h = 0;   // roi_w/h = 0: full array
+  int bin_x = 1, bin_y = 1;
+  int skip_x = 1, skip_y = 1;
+};
+
+bool parse_readout_spec(const std::string& spec, ReadoutMode& m);
+
+// Output geometry and per-sample analog value for a mode on a W x H array.
+class SensorReadout {
+public:
+  bool configure(const ReadoutMode& m, int W, int H);   // false if the mode does not fit
+
+  int    out_w() const   { return ow_; }
+  int    out_h() const   { return oh_; }
+  size_t samples() const { return (size_t)ow_ * (size_t)oh_; }
+  bool   full() const    { return ow_ == W_ && oh_ == H_; }
+
+  // Analog level of output sample n (raster order) from the full-array image
+  double sample(const std::vector<uint8_t>& img, size_t n) const;
+
+private:
+  ReadoutMode m_;
+  int W_ = 0, H_ = 0, ow_ = 0, oh_ = 0;
+};
@@ -0,0 +1,186 @@
+#include "ShmRing.h"
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <new>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+static const char RING_MAGIC[8] = { 'I','S','P','R','I','N','G','1' };
+
+static inline void cpu_relax(unsigned& spins) {
+  // short busy wait, then give the core away
+  if (++spins < 256) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+  } else {
+    std::this_thread::yield();
+  }
+}
+
+std::unique_ptr<ShmRing> ShmRing::create(const std::string& name, TraceKind kind,
+                                         uint64_t period_ps, uint32_t slots) {
+  std::unique_ptr<ShmRing> r(new ShmRing());
+  r->name_  = name;
+  r->bytes_ = sizeof(Header) + (size_t)slots * sizeof(Slot);
+  const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) return nullptr;
+  if (ftruncate(fd, (off_t)r->bytes_) != 0) { close(fd); shm_unlink(name.c_str()); return nullptr; }
+  void* p = mmap(nullptr, r->bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) { shm_unlink(name.c_str()); return nullptr; }
+  r->owner_ = true;
+  r->h_     = new (p) Header();
+  r->slots_ = reinterpret_cast<Slot*>(r->h_ + 1);
+  r->h_->kind      = kind;
+  r->h_->slots     = slots;
+  r->h_->period_ps = period_ps;
+  r->h_->head = 0; r->h_->horizon = 0; r->h_->tail = 0;
+  r->h_->stop = 0; r->h_->detached = 0; r->h_->child_pid = 0;
+  r->h_->parent_pid = (int32_t)getpid();
+  std::memcpy(r->h_->magic, RING_MAGIC, 8);   // valid once the fields are set
+  return r;
+}
+
+std::unique_ptr<ShmRing> ShmRing::attach(const std::string& name) {
+  const int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) return nullptr;
+  Header probe;
+  if (pread(fd, &probe, sizeof(Header), 0) != (ssize_t)sizeof(Header) ||
+      std::memcmp(probe.magic, RING_MAGIC, 8) != 0) { close(fd); return nullptr; }
+  std::unique_ptr<ShmRing> r(new ShmRing());
+  r->name_  = name;
+  r->bytes_ = sizeof(Header) + (size_t)probe.slots * sizeof(Slot);
+  void* p = mmap(nullptr, r->bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) return nullptr;
+  r->h_     = static_cast<Header*>(p);
+  r->slots_ = reinterpret_cast<Slot*>(r->h_ + 1);
+  return r;
+}
+
+ShmRing::~ShmRing() {
+  if (!h_) return;
+  if (producer_) {
+    // a clean finish ends the stream like the end of a trace file
+    h_->horizon.store(~0ull, std::memory_order_release);
+    h_->detached.store(1, std::memory_order_release);
+  }
+  munmap(h_, bytes_);
+  if (owner_) shm_unlink(name_.c_str());
+}
+
+void ShmRing::set_producer() {
+  producer_ = true;
+}
+
+bool ShmRing::producer_alive() const {
+  if (h_->detached.load(std::memory_order_acquire)) return false;
+  const pid_t pid = h_->child_pid.load(std::memory_order_acquire);
+  if (pid <= 0) return true;
+  // exited? (WNOWAIT: leave it for reap_producer)
+  siginfo_t info;
+  info.si_pid = 0;
+  if (waitid(P_PID, (id_t)pid, &info, WEXITED | WNOHANG | WNOWAIT) != 0) return false;
+  return info.si_pid != pid;
+}
+
+bool ShmRing::consumer_alive() const {
+  // the front end is the back end's child: reparented means it died
+  const pid_t pid = h_->parent_pid.load(std::memory_order_acquire);
+  return pid <= 0 || getppid() == pid;
+}
+
+bool ShmRing::stop_requested() const {
+  if (h_->stop.load(std::memory_order_acquire)) return true;
+  if (!orphaned_ && (++stop_checks_ & 0xFFF) == 0 && !consumer_alive()) {
+    orphaned_ = true;
+    std::cerr << "[SPLIT] Back end (pid " << h_->parent_pid.load() << ") is gone; stopping the front end\n";
+  }
+  return orphaned_;
+}
+
+int ShmRing::reap_producer() {
+  const pid_t pid = h_->child_pid.load(std::memory_order_acquire);
+  if (pid <= 0) return -1;
+  int st = 0;
+  if (waitpid(pid, &st, 0) != pid) return -1;
+  return WIFEXITED(st) ? WEXITSTATUS(st) : 128 + WTERMSIG(st);
+}
+
+bool ShmRing::push(uint64_t cycle, uint8_t flags, const uint8_t* payload) {
+  const uint64_t head = h_->head.load(std::memory_order_relaxed);
+  if (head - h_->tail.load(std::memory_order_acquire) >= h_->slots) {
+    const auto t0 = std::chrono::steady_clock::now();
+    unsigned spins = 0;
+    while (head - h_->tail.load(std::memory_order_acquire) >= h_->slots) {
+      if (stop_requested()) return false;
+      if ((spins & 0xFFFF) == 0xFFFF && !consumer_alive()) { orphaned_ = true; return false; }
+      cpu_relax(spins);
+    }
+    wait_ns_ += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - t0).count();
+    ++waits_;
+  }
+  Slot& s = slots_[head % h_->slots];
+  s.cycle = cycle;
+  s.flags = flags;
+  std::memcpy(s.payload, payload, trace_payload_bytes(kind(), flags));
+  h_->head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+bool ShmRing::pop(uint64_t& cycle, uint8_t& flags, uint8_t* payload) {
+  const uint64_t tail = h_->tail.load(std::memory_order_relaxed);
+  if (tail == h_->head.load(std::memory_order_acquire)) return false;
+  const Slot& s = slots_[tail % h_->slots];
+  cycle = s.cycle;
+  flags = s.flags;
+  std::memcpy(payload, s.payload, trace_payload_bytes(kind(), flags));
+  h_->tail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+bool ShmRing::wait_horizon(uint64_t cycle) {
+  if (h_->horizon.load(std::memory_order_acquire) > cycle) return true;
+  const auto t0 = std::chrono::steady_clock::now();
+  unsigned spins = 0, checks = 0;
+  bool ok = true;
+  while (h_->horizon.load(std::memory_order_acquire) <= cycle) {
+    if ((++checks & 0xFFFF) == 0 && !producer_alive()) {
+      ok = h_->horizon.load(std::memory_order_acquire) > cycle;
+      break;
+    }
+    cpu_relax(spins);
+  }
+  wait_ns_ += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - t0).count();
+  ++waits_;
+  return ok;
+}
+
+pid_t spawn_self(int argc, char* argv[], const std::string& extra) {
+  std::vector<std::string> args(argv, argv + argc);
+  args.push_back(extra);
+  std::vector<char*> av;
+  for (std::string& s : args) av.push_back(&s[0]);
+  av.push_back(nullptr);
+  std::cout.flush();
+  const pid_t parent = getpid();
+  const pid_t pid = fork();
+  if (pid == 0) {
+    // do not outlive the back end (it may have died before prctl took effect)
+    prctl(PR_SET_PDEATHSIG, SIGTERM);
+    if (getppid() != parent) _exit(127);
+    execv("/proc/self/exe", av.data());
+    _exit(127);
+  }
+  return pid;
+}
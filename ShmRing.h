@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include "StreamTrace.h"
+
+// Single-producer / single-consumer ring of interface records in POSIX
+// shared memory, for running the pipeline as two processes (--split=).
+// The producer (front end) pushes the records it samples, as the trace
+// recorders do, and publishes a horizon: every cycle below it has been
+// sampled. The consumer (back end) drives cycle c only once the horizon has
+// passed c, which is exact because the split interfaces carry no
+// backpressure (conservative synchronization, one direction). When the
+// consumer finishes it raises stop and the producer ends its run; a
+// producer whose consumer process died ends its run the same way.
+class ShmRing {
+public:
+  struct Slot {
+    uint64_t cycle;
+    uint8_t  flags;
+    uint8_t  payload[32];
+    uint8_t  pad[7];
+  };
+  struct Header {
+    char     magic[8];
+    uint32_t kind, slots;
+    uint64_t period_ps;
+    alignas(64) std::atomic<uint64_t> head;       // records pushed
+    alignas(64) std::atomic<uint64_t> horizon;    // producer sampled every cycle < horizon
+    alignas(64) std::atomic<uint64_t> tail;       // records popped
+    alignas(64) std::atomic<uint32_t> stop;       // consumer finished
+    std::atomic<uint32_t> detached;               // producer finished (horizon set to max)
+    std::atomic<int32_t>  child_pid;              // front-end process, watched by the consumer
+    std::atomic<int32_t>  parent_pid;             // back-end process, watched by the producer
+  };
+  static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring needs lock-free 64-bit atomics");
+
+  static std::unique_ptr<ShmRing> create(const std::string& name, TraceKind kind,
+                                         uint64_t period_ps, uint32_t slots = 1u << 16);
+  static std::unique_ptr<ShmRing> attach(const std::string& name);
+  ~ShmRing();
+
+  TraceKind kind()      const { return (TraceKind)h_->kind; }
+  uint64_t  period_ps() const { return h_->period_ps; }
+
+  // Producer
+  void set_producer();
+  bool push(uint64_t cycle, uint8_t flags, const uint8_t* payload);   // spins while full; false once stopped
+  void publish(uint64_t horizon) { h_->horizon.store(horizon, std::memory_order_release); }
+  bool stop_requested() const;         // consumer finished, or its process is gone
+
+  // Consumer
+  bool pop(uint64_t& cycle, uint8_t& flags, uint8_t* payload);        // non-blocking
+  bool wait_horizon(uint64_t cycle);    // false if the producer went away first
+  void request_stop() { h_->stop.store(1, std::memory_order_release); }
+  void watch_producer(pid_t pid) { h_->child_pid.store((int32_t)pid, std::memory_order_release); }
+  int  reap_producer();                               // waits for it; exit status, -1 if none
+
+  // Wall-clock time one side spent waiting on the other
+  double wait_seconds() const { return wait_ns_ * 1e-9; }
+  uint64_t waits() const { return waits_; }
+
+private:
+  ShmRing() = default;
+  std::string name_;
+  Header* h_ = nullptr;
+  Slot*   slots_ = nullptr;
+  size_t  bytes_ = 0;
+  bool    owner_ = false, producer_ = false;
+  uint64_t wait_ns_ = 0, waits_ = 0;
+
+  mutable uint32_t stop_checks_ = 0;
+  mutable bool     orphaned_ = false;
+
+  bool producer_alive() const;
+  bool consumer_alive() const;
+};
+
+// Re-runs this executable with argv plus 'extra' (the front-end process).
+// The child gets SIGTERM if this process dies.
+pid_t spawn_self(int argc, char* argv[], const std::string& extra);
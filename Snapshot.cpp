@@ -0,0 +1,54 @@
+#include "Snapshot.h"
+#include <fstream>
+
+static const char SNAP_MAGIC[8] = { 'I','S','P','S','N','A','P','1' };
+
+void Snapshot::add(const char tag[4], const SnapBuf& payload) {
+  Section s;
+  std::memcpy(s.tag, tag, 4);
+  s.data = payload.b;
+  sections_.push_back(std::move(s));
+}
+
+const std::vector<uint8_t>* Snapshot::find(const char tag[4]) const {
+  for (const Section& s : sections_)
+    if (std::memcmp(s.tag, tag, 4) == 0) return &s.data;
+  return nullptr;
+}
+
+bool Snapshot::save(const std::string& path) const {
+  std::ofstream f(path, std::ios::binary);
+  if (!f) return false;
+  f.write(SNAP_MAGIC, 8);
+  f.write(reinterpret_cast<const char*>(&W), 4);
+  f.write(reinterpret_cast<const char*>(&H), 4);
+  f.write(reinterpret_cast<const char*>(&codec), 4);
+  for (const Section& s : sections_) {
+    const uint64_t n = s.data.size();
+    f.write(s.tag, 4);
+    f.write(reinterpret_cast<const char*>(&n), 8);
+    f.write(reinterpret_cast<const char*>(s.data.data()), (std::streamsize)n);
+  }
+  return (bool)f;
+}
+
+bool Snapshot::load(const std::string& path) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f) return false;
+  char magic[8];
+  if (!f.read(magic, 8) || std::memcmp(magic, SNAP_MAGIC, 8) != 0) return false;
+  f.read(reinterpret_cast<char*>(&W), 4);
+  f.read(reinterpret_cast<char*>(&H), 4);
+  f.read(reinterpret_cast<char*>(&codec), 4);
+  if (!f) return false;
+
+  sections_.clear();
+  Section s;
+  uint64_t n = 0;
+  while (f.read(s.tag, 4) && f.read(reinterpret_cast<char*>(&n), 8)) {
+    s.data.resize((size_t)n);
+    if (!f.read(reinterpret_cast<char*>(s.data.data()), (std::streamsize)n)) return false;
+    sections_.push_back(s);
+  }
+  return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Binary pipeline snapshot for warm-started runs.
+//   header : "ISPSNAP1", u32 W, u32 H, u32 codec
+//   section: char tag[4], u64 length, payload   (repeated)
+// Sections: "LPDR" LPDDR contents + counters, "LUT1" post-ISP table +
+// histograms, "ISPF" ISP frame buffers. All integers little-endian host order.
+
+// Append-only payload builder
+struct SnapBuf {
+  std::vector<uint8_t> b;
+  void raw(const void* p, size_t n) {
+    const uint8_t* s = static_cast<const uint8_t*>(p);
+    b.insert(b.end(), s, s + n);
+  }
+  void u8 (uint8_t v)  { raw(&v, 1); }
+  void u32(uint32_t v) { raw(&v, 4); }
+  void u64(uint64_t v) { raw(&v, 8); }
+  void f64(double v)   { raw(&v, 8); }
+  void bytes(const std::vector<uint8_t>& v) { u64(v.size()); raw(v.data(), v.size()); }
+};
+
+// Bounds-checked payload reader; ok() turns false on the first overrun
+struct SnapCursor {
+  SnapCursor(const std::vector<uint8_t>& v) : p_(v.data()), end_(v.data() + v.size()) {}
+  bool ok() const { return ok_; }
+  bool raw(void* d, size_t n) {
+    if (!ok_ || (size_t)(end_ - p_) < n) { ok_ = false; return false; }
+    std::memcpy(d, p_, n); p_ += n; return true;
+  }
+  uint8_t  u8()  { uint8_t  v = 0; raw(&v, 1); return v; }
+  uint32_t u32() { uint32_t v = 0; raw(&v, 4); return v; }
+  uint64_t u64() { uint64_t v = 0; raw(&v, 8); return v; }
+  double   f64() { double   v = 0; raw(&v, 8); return v; }
+  bool bytes(std::vector<uint8_t>& v) {
+    const uint64_t n = u64();
+    if (!ok_ || (uint64_t)(end_ - p_) < n) { ok_ = false; return false; }
+    v.assign(p_, p_ + n); p_ += n; return true;
+  }
+
+private:
+  const uint8_t* p_;
+  const uint8_t* end_;
+  bool ok_ = true;
+};
+
+struct Snapshot {
+  uint32_t W = 0, H = 0, codec = 0;
+
+  void add(const char tag[4], const SnapBuf& payload);
+  const std::vector<uint8_t>* find(const char tag[4]) const;
+
+  bool save(const std::string& path) const;
+  bool load(const std::string& path);
+
+private:
+  struct Section { char tag[4]; std::vector<uint8_t> data; };
+  std::vector<Section> sections_;
+};
@@ -0,0 +1,114 @@
+#include "StreamTrace.h"
+#include "ShmRing.h"
+#include <cstring>
+
+static const char TRACE_MAGIC[8] = { 'I','S','P','T','R','A','C','E' };
+static const uint8_t TRACE_VERSION = 1;
+
+static bool shm_path(const std::string& path, std::string& name) {
+  if (path.compare(0, 4, "shm:") != 0) return false;
+  name = path.substr(4);
+  return true;
+}
+
+TraceWriter::TraceWriter() = default;
+TraceWriter::~TraceWriter() = default;
+
+bool TraceWriter::open(const std::string& path, TraceKind kind, uint64_t period_ps) {
+  std::string name;
+  if (shm_path(path, name)) {
+    ring_ = ShmRing::attach(name);
+    if (!ring_ || ring_->kind() != kind || ring_->period_ps() != period_ps) { ring_.reset(); return false; }
+    ring_->set_producer();
+    kind_ = kind;
+    last_cycle_ = records_ = 0;
+    return true;
+  }
+  f_.open(path, std::ios::binary);
+  if (!f_) return false;
+  kind_ = kind;
+  last_cycle_ = records_ = 0;
+  const uint8_t  hdr[4] = { (uint8_t)kind, TRACE_VERSION, 0, 0 };
+  f_.write(TRACE_MAGIC, 8);
+  f_.write(reinterpret_cast<const char*>(hdr), 4);
+  f_.write(reinterpret_cast<const char*>(&period_ps), 8);
+  return (bool)f_;
+}
+
+void TraceWriter::put(uint64_t cycle, uint8_t flags, const uint8_t* payload) {
+  if (ring_) {
+    if (ring_->push(cycle, flags, payload)) ++records_;
+    return;
+  }
+  if (!f_) return;
+  uint64_t d = cycle - last_cycle_;
+  last_cycle_ = cycle;
+  uint8_t buf[10 + 1 + 32];
+  unsigned n = 0;
+  do {                                  // LEB128 delta
+    uint8_t b = d & 0x7f;
+    d >>= 7;
+    buf[n++] = b | (d ? 0x80 : 0);
+  } while (d);
+  buf[n++] = flags;
+  const unsigned p = trace_payload_bytes(kind_, flags);
+  std::memcpy(buf + n, payload, p);
+  f_.write(reinterpret_cast<const char*>(buf), n + p);
+  ++records_;
+}
+
+void TraceWriter::advance(uint64_t cycle) {
+  if (ring_) ring_->publish(cycle);
+}
+
+bool TraceWriter::stopped() const {
+  return ring_ && ring_->stop_requested();
+}
+
+TraceReader::TraceReader() = default;
+TraceReader::~TraceReader() = default;
+
+bool TraceReader::open(const std::string& path) {
+  std::string name;
+  if (shm_path(path, name)) {
+    ring_ = ShmRing::attach(name);
+    if (!ring_) return false;
+    kind_      = ring_->kind();
+    period_ps_ = ring_->period_ps();
+    return true;
+  }
+  f_.open(path, std::ios::binary);
+  if (!f_) return false;
+  char magic[8];
+  uint8_t hdr[4];
+  if (!f_.read(magic, 8) || std::memcmp(magic, TRACE_MAGIC, 8) != 0) return false;
+  if (!f_.read(reinterpret_cast<char*>(hdr), 4) || hdr[1] != TRACE_VERSION) return false;
+  if (!f_.read(reinterpret_cast<char*>(&period_ps_), 8)) return false;
+  kind_  = (TraceKind)hdr[0];
+  cycle_ = 0;
+  return true;
+}
+
+bool TraceReader::sync(uint64_t cycle) {
+  return !ring_ || ring_->wait_horizon(cycle);
+}
+
+bool TraceReader::next(uint64_t& cycle, uint8_t& flags, uint8_t* payload) {
+  if (ring_) return ring_->pop(cycle, flags, payload);
+  uint64_t d = 0;
+  unsigned shift = 0;
+  char b = 0;
+  do {
+    if (!f_.get(b)) return false;
+    d |= (uint64_t)((uint8_t)b & 0x7f) << shift;
+    shift += 7;
+  } while (((uint8_t)b & 0x80) && shift < 64);
+  char fl;
+  if (!f_.get(fl)) return false;
+  flags = (uint8_t)fl;
+  const unsigned p = trace_payload_bytes(kind_, flags);
+  if (p && !f_.read(reinterpret_cast<char*>(payload), p)) return false;
+  cycle_ += d;
+  cycle   = cycle_;
+  return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+// Compact binary trace of one pipeline interface for record/replay.
+//   header : "ISPTRACE", u8 kind, u8 version, u16 0, u64 clock period (ps)
+//   record : LEB128 cycle delta from the previous record, u8 flags, payload
+// Only active cycles are stored. Pixel streams: flags bit0 valid, bit1 vsync;
+// 1 payload byte when valid. 256-bit bus: one record per accepted beat,
+// flags bit0 valid, bit1 last; 32 payload bytes (lane 0 first).
+// A path "shm:<name>" attaches to a live ShmRing instead of a file (--split).
+enum TraceKind : uint8_t { TRACE_PIXEL = 0, TRACE_BUS256 = 1 };
+
+static const uint8_t TRACE_VALID = 0x01;
+static const uint8_t TRACE_LAST  = 0x02;   // vsync (pixel) / wlast (bus)
+
+inline unsigned trace_payload_bytes(TraceKind k, uint8_t flags) {
+  if (!(flags & TRACE_VALID)) return 0;
+  return k == TRACE_PIXEL ? 1u : 32u;
+}
+
+class ShmRing;
+
+class TraceWriter {
+public:
+  TraceWriter();
+  ~TraceWriter();
+  bool open(const std::string& path, TraceKind kind, uint64_t period_ps);
+  void put(uint64_t cycle, uint8_t flags, const uint8_t* payload);
+  void advance(uint64_t cycle);      // ring: every cycle below 'cycle' has been sampled
+  bool stopped() const;              // ring: the consumer has finished
+  const ShmRing* ring() const { return ring_.get(); }
+  uint64_t records() const { return records_; }
+  void close() { if (f_.is_open()) f_.close(); }
+
+private:
+  std::ofstream f_;
+  std::unique_ptr<ShmRing> ring_;
+  TraceKind kind_ = TRACE_PIXEL;
+  uint64_t  last_cycle_ = 0, records_ = 0;
+};
+
+class TraceReader {
+public:
+  TraceReader();
+  ~TraceReader();
+  bool open(const std::string& path);
+  TraceKind kind()      const { return kind_; }
+  uint64_t  period_ps() const { return period_ps_; }
+  // false at end of trace (ring: no record available yet); payload must hold 32 bytes
+  bool next(uint64_t& cycle, uint8_t& flags, uint8_t* payload);
+  // ring: wait until the producer has sampled 'cycle'; false if it went away
+  bool sync(uint64_t cycle);
+  const ShmRing* ring() const { return ring_.get(); }
+
+private:
+  std::ifstream f_;
+  std::unique_ptr<ShmRing> ring_;
+  TraceKind kind_ = TRACE_PIXEL;
+  uint64_t  period_ps_ = 0, cycle_ = 0;
+};
@@ -0,0 +1,223 @@
+#include "SystemCache256.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+static uint32_t parse_size(const std::string& v) {
+  size_t pos = 0;
+  double n = std::stod(v, &pos);
+  const char u = pos < v.size() ? v[pos] : '\0';
+  if (u == 'K' || u == 'k') n *= 1024.0;
+  else if (u == 'M' || u == 'm') n *= 1024.0 * 1024.0;
+  return (uint32_t)n;
+}
+
+bool parse_cache_spec(const std::string& spec, CacheConfig& cfg) {
+  std::stringstream ss(spec);
+  std::string kv;
+  while (std::getline(ss, kv, ',')) {
+    if (kv.empty()) continue;
+    const size_t eq = kv.find('=');
+    const std::string k = kv.substr(0, eq);
+    const std::string v = (eq == std::string::npos) ? "1" : kv.substr(eq + 1);
+    if      (k == "size")   cfg.size_bytes  = parse_size(v);
+    else if (k == "ways")   cfg.ways        = (uint32_t)std::stoul(v);
+    else if (k == "line")   cfg.line_bytes  = (uint32_t)std::stoul(v);
+    else if (k == "policy") cfg.write_back  = (v != "wt");
+    else if (k == "alloc")  cfg.write_alloc = (v != "0");
+    else if (k == "repl")   cfg.lru         = (v != "rand");
+    else if (k == "hit")    cfg.hit_cycles  = (unsigned)std::stoul(v);
+    else if (k == "miss")   cfg.miss_cycles = (unsigned)std::stoul(v);
+    else if (k == "wb")     cfg.wb_cycles   = (unsigned)std::stoul(v);
+    else if (k == "queue")  cfg.queue       = (unsigned)std::stoul(v);
+    else if (k == "seed")   cfg.seed        = (uint32_t)std::stoul(v);
+    else {
+      std::cerr << "[WARN] Unknown cache key '" << k << "'\n";
+      return false;
+    }
+  }
+  cfg.line_bytes = std::max(32u, cfg.line_bytes / 32 * 32);
+  cfg.ways       = std::max(1u, cfg.ways);
+  cfg.hit_cycles = std::max(1u, cfg.hit_cycles);
+  cfg.queue      = std::max(2u, cfg.queue);
+  if (cfg.size_bytes < cfg.line_bytes * cfg.ways) {
+    std::cerr << "[WARN] Cache smaller than one set\n";
+    return false;
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------- tags
+
+CacheTags::CacheTags(const CacheConfig& cfg)
+: cfg_(cfg), sets_(std::max(1u, cfg.size_bytes / (cfg.line_bytes * cfg.ways))),
+  lines_((size_t)sets_ * cfg.ways), rng_(cfg.seed ? cfg.seed : 1) {}
+
+unsigned CacheTags::victim(Line* set) {
+  for (unsigned w = 0; w < cfg_.ways; ++w)
+    if (!set[w].valid) return w;
+  if (!cfg_.lru) {
+    rng_ ^= rng_ << 13; rng_ ^= rng_ >> 17; rng_ ^= rng_ << 5;   // xorshift32
+    return rng_ % cfg_.ways;
+  }
+  unsigned v = 0;
+  for (unsigned w = 1; w < cfg_.ways; ++w)
+    if (set[w].stamp < set[v].stamp) v = w;
+  return v;
+}
+
+CacheTags::Result CacheTags::access(uint64_t addr, bool write) {
+  Result r;
+  const uint64_t line = addr / cfg_.line_bytes;
+  const uint64_t tag  = line / sets_;
+  Line* set = &lines_[(size_t)(line % sets_) * cfg_.ways];
+  ++clock_;
+
+  for (unsigned w = 0; w < cfg_.ways; ++w) {
+    if (set[w].valid && set[w].tag == tag) {
+      r.hit = true;
+      set[w].stamp = clock_;
+      if (write) { if (cfg_.write_back) set[w].dirty = true; else r.through = true; }
+      return r;
+    }
+  }
+  if (write && !cfg_.write_alloc) { r.through = true; return r; }
+
+  // allocate: evict, then fetch the line (fetch-on-write for write misses)
+  Line& v = set[victim(set)];
+  r.writeback = v.valid && v.dirty;
+  r.fill      = true;
+  v.valid = true;
+  v.tag   = tag;
+  v.stamp = clock_;
+  v.dirty = write && cfg_.write_back;
+  r.through = write && !cfg_.write_back;
+  return r;
+}
+
+uint64_t CacheTags::dirty_lines() const {
+  uint64_t n = 0;
+  for (const Line& l : lines_) n += (l.valid && l.dirty) ? 1 : 0;
+  return n;
+}
+
+// ---------------------------------------------------------------- module
+
+SystemCache256::SystemCache256(sc_core::sc_module_name name, const CacheConfig& cfg)
+: sc_module(name),
+  clk("clk"),
+  s_wdata("s_wdata"), s_wvalid("s_wvalid"), s_wlast("s_wlast"), s_wready("s_wready"),
+  m_wdata("m_wdata"), m_wvalid("m_wvalid"), m_wlast("m_wlast"), m_wready("m_wready"),
+  m_rdata("m_rdata"), m_rvalid("m_rvalid"), m_rready("m_rready"),
+  s_rdata("s_rdata"), s_rvalid("s_rvalid"), s_rready("s_rready"),
+  cfg_(cfg), tags_(cfg) {
+  SC_CTHREAD(run, clk.pos());
+}
+
+unsigned SystemCache256::drain_cycles() const {
+  return (cfg_.queue + 2) * (cfg_.hit_cycles + cfg_.miss_cycles + cfg_.wb_cycles) + 4;
+}
+
+void SystemCache256::run() {
+  s_wready.write(false);
+  m_rready.write(false);
+  m_wvalid.write(false);
+  m_wlast.write(false);
+  s_rvalid.write(false);
+  wait();
+  for (;;) {
+    ++cycle_;
+    step(wr_, true,  s_wdata, s_wvalid, &s_wlast, s_wready, m_wdata, m_wvalid, &m_wlast, m_wready);
+    step(rd_, false, m_rdata, m_rvalid, nullptr,  m_rready, s_rdata, s_rvalid, nullptr,  s_rready);
+    wait();
+  }
+}
+
+void SystemCache256::step(Chan& ch, bool write,
+                          const sc_core::sc_in< sc_dt::sc_bv<256> >& din, const sc_core::sc_in<bool>& vin,
+                          const sc_core::sc_in<bool>* lin, sc_core::sc_out<bool>& rdy_out,
+                          sc_core::sc_out< sc_dt::sc_bv<256> >& dout, sc_core::sc_out<bool>& vout,
+                          sc_core::sc_out<bool>* lout, const sc_core::sc_in<bool>& rdy_in) {
+  // Accept: a packer-style source presented this beat against the ready we
+  // drove two edges ago; an AsyncFifo read side pops on the current ready.
+  if (vin.read()) {
+    if (ch.src_fifo ? ch.rdy_q1 : ch.rdy_q2) {
+      Beat b{din.read(), lin ? lin->read() : false, 0, cycle_};
+      if (write) {
+        if (waddr_ == 0) raddr_ = 0;        // new frame: read-out restarts at 0
+        b.addr = waddr_;
+        waddr_ = b.last ? 0 : waddr_ + 32;
+      } else {
+        b.addr = raddr_;
+        raddr_ += 32;
+      }
+      ch.q.push_back(b);
+    } else {
+      ++ch.stall;
+    }
+  }
+
+  // Tag pipeline: one beat at a time, held for its hit / miss latency
+  if (!ch.svc && !ch.q.empty()) {
+    ch.cur = ch.q.front();
+    ch.q.pop_front();
+    ch.svc = true;
+    const CacheTags::Result r = tags_.access(ch.cur.addr, write);
+    ch.busy = cfg_.hit_cycles;
+    if (r.hit) ++ch.hits; else ++ch.misses;
+    if (r.fill)      { ++fills_;      ch.busy += cfg_.miss_cycles; }
+    if (r.writeback) { ++writebacks_; ch.busy += cfg_.wb_cycles; }
+    if (r.through)   through_bytes_ += 32;
+  }
+  if (ch.svc) {
+    if (ch.busy) --ch.busy;
+    if (ch.busy == 0 && !ch.out_full) {
+      ch.out = ch.cur;
+      ch.out_full = true;
+      ch.svc = false;
+      ch.lat_sum += cycle_ - ch.out.t_in + 1;
+      ++ch.beats;
+    }
+  }
+
+  // Present like the packer: the beat is taken if ready is high on this edge
+  if (ch.out_full) {
+    dout.write(ch.out.data);
+    vout.write(true);
+    if (lout) lout->write(ch.out.last);
+    if (rdy_in.read()) ch.out_full = false;
+  } else {
+    vout.write(false);
+    if (lout) lout->write(false);
+  }
+
+  const bool rdy = ch.q.size() + 1 < cfg_.queue;
+  rdy_out.write(rdy);
+  ch.rdy_q2 = ch.rdy_q1;
+  ch.rdy_q1 = rdy;
+}
+
+void SystemCache256::report() const {
+  auto pct = [](uint64_t n, uint64_t d){ return d ? 100.0 * (double)n / (double)d : 0.0; };
+  auto avg = [](uint64_t n, uint64_t d){ return d ? (double)n / (double)d : 0.0; };
+  const uint64_t line     = cfg_.line_bytes;
+  const uint64_t uncached = (wr_.beats + rd_.beats) * 32;
+  const uint64_t dram     = (fills_ + writebacks_) * line + through_bytes_;
+  const uint64_t dirty    = tags_.dirty_lines() * line;
+
+  std::cout << "[CACHE] " << cfg_.size_bytes / 1024 << " KB " << cfg_.ways << "-way "
+            << line << " B lines (" << tags_.sets() << " sets) "
+            << (cfg_.write_back ? "write-back" : "write-through") << " "
+            << (cfg_.write_alloc ? "write-allocate" : "no-write-allocate") << " "
+            << (cfg_.lru ? "LRU" : "random") << "\n";
+  std::cout << "[CACHE] write beats=" << wr_.beats << " hit=" << pct(wr_.hits, wr_.hits + wr_.misses)
+            << "% | read beats=" << rd_.beats << " hit=" << pct(rd_.hits, rd_.hits + rd_.misses) << "%\n";
+  std::cout << "[CACHE] DRAM traffic fills=" << fills_ << " writebacks=" << writebacks_
+            << " write-through=" << through_bytes_ << " B | total=" << dram << " B vs "
+            << uncached << " B uncached (saved "
+            << (uncached ? 100.0 * ((double)uncached - (double)dram) / (double)uncached : 0.0)
+            << "%), dirty at end=" << dirty << " B\n";
+  std::cout << "[CACHE] latency write=" << avg(wr_.lat_sum, wr_.beats) << " read="
+            << avg(rd_.lat_sum, rd_.beats) << " cycles/beat, upstream stalls write="
+            << wr_.stall << " read=" << rd_.stall << " cycles\n";
+}
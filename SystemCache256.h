@@ -0,0 +1,114 @@
+#pragma once
+#include <systemc>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Shared last-level cache configuration.
+// CLI form: --cache=size=256K,ways=8,line=64,policy=wb|wt,alloc=1,repl=lru|rand,
+//                   hit=1,miss=40,wb=20,queue=4,seed=1
+struct CacheConfig {
+  uint32_t size_bytes  = 256 * 1024;
+  uint32_t ways        = 8;
+  uint32_t line_bytes  = 64;          // multiple of the 32-byte beat
+  bool     write_back  = true;        // false: write-through
+  bool     write_alloc = true;        // false: write misses bypass the cache
+  bool     lru         = true;        // false: random replacement
+  unsigned hit_cycles  = 1;           // tag lookup + data array
+  unsigned miss_cycles = 40;          // line fill from LPDDR (added to hit)
+  unsigned wb_cycles   = 20;          // dirty victim write-back (added to miss)
+  unsigned queue       = 4;           // request queue per channel
+  uint32_t seed        = 1;           // random replacement
+};
+
+bool parse_cache_spec(const std::string& spec, CacheConfig& cfg);
+
+// Set-associative tag model (no data: LPDDR stays the backing store).
+class CacheTags {
+public:
+  struct Result { bool hit = false, fill = false, writeback = false, through = false; };
+
+  explicit CacheTags(const CacheConfig& cfg);
+  Result access(uint64_t addr, bool write);
+  uint64_t dirty_lines() const;
+  uint32_t sets() const { return sets_; }
+
+private:
+  struct Line { uint64_t tag = 0; uint64_t stamp = 0; bool valid = false, dirty = false; };
+  const CacheConfig cfg_;
+  uint32_t sets_;
+  std::vector<Line> lines_;           // sets_ * ways
+  uint64_t clock_ = 0;
+  uint32_t rng_;
+
+  unsigned victim(Line* set);
+};
+
+// Inline cache on both 256-bit channels, between the write bus and LPDDR
+// and between the LPDDR read port and the read consumer. Beats are
+// addressed by their offset in the frame (writes restart after wlast, reads
+// after the first write of a frame). Every beat is still forwarded to the
+// LPDDR so storage and read-back stay exact; the cache decides how long the
+// beat is held (hit, fill, write-back) and what DRAM traffic a real LLC
+// would have issued.
+struct SystemCache256 : sc_core::sc_module {
+  sc_core::sc_in<bool> clk;
+
+  // Write: upstream (packer / CDC FIFO) side
+  sc_core::sc_in< sc_dt::sc_bv<256> >  s_wdata;
+  sc_core::sc_in<bool>                 s_wvalid;
+  sc_core::sc_in<bool>                 s_wlast;
+  sc_core::sc_out<bool>                s_wready;
+  // Write: LPDDR side
+  sc_core::sc_out< sc_dt::sc_bv<256> > m_wdata;
+  sc_core::sc_out<bool>                m_wvalid;
+  sc_core::sc_out<bool>                m_wlast;
+  sc_core::sc_in<bool>                 m_wready;
+
+  // Read: LPDDR side
+  sc_core::sc_in< sc_dt::sc_bv<256> >  m_rdata;
+  sc_core::sc_in<bool>                 m_rvalid;
+  sc_core::sc_out<bool>                m_rready;
+  // Read: consumer side
+  sc_core::sc_out< sc_dt::sc_bv<256> > s_rdata;
+  sc_core::sc_out<bool>                s_rvalid;
+  sc_core::sc_in<bool>                 s_rready;
+
+  SC_HAS_PROCESS(SystemCache256);
+  SystemCache256(sc_core::sc_module_name name, const CacheConfig& cfg);
+
+  // Write source is an AsyncFifo read side (CDC) rather than the packer
+  void set_write_source_fifo(bool en) { wr_.src_fifo = en; }
+  // Worst-case cycles to empty both channels (LPDDR stop drain)
+  unsigned drain_cycles() const;
+  void report() const;
+
+private:
+  struct Beat { sc_dt::sc_bv<256> data; bool last; uint64_t addr; uint64_t t_in; };
+  struct Chan {
+    std::deque<Beat> q;               // accepted, waiting for the tag pipeline
+    Beat     cur, out;
+    unsigned busy = 0;
+    bool     svc = false, out_full = false, src_fifo = false;
+    bool     rdy_q1 = false, rdy_q2 = false;   // ready driven 1 and 2 edges ago
+    uint64_t beats = 0, hits = 0, misses = 0;
+    uint64_t lat_sum = 0, stall = 0;
+  };
+
+  const CacheConfig cfg_;
+  CacheTags tags_;
+  Chan      wr_, rd_;
+  uint64_t  cycle_ = 0;
+  uint64_t  waddr_ = 0, raddr_ = 0;
+
+  // DRAM-side traffic a cached system would issue
+  uint64_t fills_ = 0, writebacks_ = 0, through_bytes_ = 0;
+
+  void run();
+  void step(Chan& ch, bool write,
+            const sc_core::sc_in< sc_dt::sc_bv<256> >& din, const sc_core::sc_in<bool>& vin,
+            const sc_core::sc_in<bool>* lin, sc_core::sc_out<bool>& rdy_out,
+            sc_core::sc_out< sc_dt::sc_bv<256> >& dout, sc_core::sc_out<bool>& vout,
+            sc_core::sc_out<bool>* lout, const sc_core::sc_in<bool>& rdy_in);
+};
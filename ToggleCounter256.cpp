@@ -0,0 +1,18 @@
+#include "ToggleCounter256.h"
+#include "Popcount.h"
+
+ToggleCounter256::ToggleCounter256(sc_core::sc_module_name name, uint64_t* count)
+: sc_module(name), data_in("data_in"), count_(count) {
+  SC_METHOD(on_change);
+  sensitive << data_in;
+  dont_initialize();
+}
+
+void ToggleCounter256::on_change() {
+  const sc_dt::sc_bv<256>& v = data_in.read();
+  alignas(32) uint64_t cur[4];
+  for (int i = 0; i < 4; ++i)
+    cur[i] = (uint64_t)v.get_word(2*i) | ((uint64_t)v.get_word(2*i + 1) << 32);
+  *count_ += toggles256(cur, prev_);
+  for (int i = 0; i < 4; ++i) prev_[i] = cur[i];
+}
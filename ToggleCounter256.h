@@ -0,0 +1,18 @@
+#pragma once
+#include <systemc>
+#include <cstdint>
+
+// Passive wire-activity probe on a 256-bit bus: on every value change adds
+// popcount(new ^ old) to *count (SIMD popcount, see Popcount.h).
+struct ToggleCounter256 : sc_core::sc_module {
+  sc_core::sc_in< sc_dt::sc_bv<256> > data_in;
+
+  SC_HAS_PROCESS(ToggleCounter256);
+  ToggleCounter256(sc_core::sc_module_name name, uint64_t* count);
+
+private:
+  uint64_t* count_;
+  alignas(32) uint64_t prev_[4] = {0, 0, 0, 0};
+
+  void on_change();
+};
@@ -0,0 +1,65 @@
+#include "TraceRecorder.h"
+#include <iostream>
+
+static inline uint64_t period_ps(const sc_core::sc_time& t) {
+  return (uint64_t)(t.to_seconds() * 1e12 + 0.5);
+}
+
+PixelTraceRecorder::PixelTraceRecorder(sc_core::sc_module_name name, const std::string& path,
+                                       const sc_core::sc_time& period)
+: sc_module(name), clk("clk"), pix_in("pix_in"), valid_in("valid_in"), vsync_in("vsync_in"),
+  path_(path) {
+  if (!w_.open(path, TRACE_PIXEL, period_ps(period)))
+    std::cerr << "[TRACE] Cannot write '" << path << "'\n";
+  SC_CTHREAD(run, clk.pos());
+}
+
+void PixelTraceRecorder::run() {
+  for (;;) {
+    const bool vld = valid_in.read();
+    const uint8_t flags = (vld ? TRACE_VALID : 0) | (vsync_in.read() ? TRACE_LAST : 0);
+    if (flags) {
+      const uint8_t pix = (uint8_t)pix_in.read().to_uint();
+      w_.put(cycle_, flags, &pix);
+    }
+    w_.advance(++cycle_);
+    if (w_.stopped()) sc_core::sc_stop();   // --split: the back end has finished
+    wait();
+  }
+}
+
+void PixelTraceRecorder::report() const {
+  std::cout << "[TRACE] recorded " << w_.records() << " pixel records over " << cycle_
+            << " cycles → " << path_ << "\n";
+}
+
+BusTraceRecorder::BusTraceRecorder(sc_core::sc_module_name name, const std::string& path,
+                                   const sc_core::sc_time& period)
+: sc_module(name), clk("clk"), data_in("data_in"), valid_in("valid_in"), ready_in("ready_in"),
+  last_in("last_in"), path_(path) {
+  if (!w_.open(path, TRACE_BUS256, period_ps(period)))
+    std::cerr << "[TRACE] Cannot write '" << path << "'\n";
+  SC_CTHREAD(run, clk.pos());
+}
+
+void BusTraceRecorder::run() {
+  uint8_t bytes[32];
+  for (;;) {
+    if (valid_in.read() && ready_in.read()) {
+      const sc_dt::sc_bv<256> v = data_in.read();
+      for (int i = 0; i < 8; ++i) {
+        const uint32_t w = (uint32_t)v.get_word(i);
+        for (int k = 0; k < 4; ++k) bytes[4*i + k] = (uint8_t)(w >> (8*k));
+      }
+      w_.put(cycle_, TRACE_VALID | (last_in.read() ? TRACE_LAST : 0), bytes);
+    }
+    w_.advance(++cycle_);
+    if (w_.stopped()) sc_core::sc_stop();
+    wait();
+  }
+}
+
+void BusTraceRecorder::report() const {
+  std::cout << "[TRACE] recorded " << w_.records() << " beats over " << cycle_
+            << " cycles → " << path_ << "\n";
+}
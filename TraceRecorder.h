@@ -0,0 +1,46 @@
+#pragma once
+#include <systemc>
+#include <string>
+#include "StreamTrace.h"
+
+// Passive recorders for --record=: sample the interface at every clock edge
+// and append active cycles to a StreamTrace file (cycle 0 = first edge).
+
+// 8-bit pixel stream (ADC or ISP output): pix/valid/vsync
+struct PixelTraceRecorder : sc_core::sc_module {
+  sc_core::sc_in<bool>                clk;
+  sc_core::sc_in< sc_dt::sc_uint<8> > pix_in;
+  sc_core::sc_in<bool>                valid_in;
+  sc_core::sc_in<bool>                vsync_in;
+
+  SC_HAS_PROCESS(PixelTraceRecorder);
+  PixelTraceRecorder(sc_core::sc_module_name name, const std::string& path,
+                     const sc_core::sc_time& period);
+  void report() const;
+
+private:
+  TraceWriter w_;
+  std::string path_;
+  uint64_t    cycle_ = 0;
+  void run();
+};
+
+// 256-bit bus: one record per accepted beat (valid && ready), with last
+struct BusTraceRecorder : sc_core::sc_module {
+  sc_core::sc_in<bool>                clk;
+  sc_core::sc_in< sc_dt::sc_bv<256> > data_in;
+  sc_core::sc_in<bool>                valid_in;
+  sc_core::sc_in<bool>                ready_in;
+  sc_core::sc_in<bool>                last_in;
+
+  SC_HAS_PROCESS(BusTraceRecorder);
+  BusTraceRecorder(sc_core::sc_module_name name, const std::string& path,
+                   const sc_core::sc_time& period);
+  void report() const;
+
+private:
+  TraceWriter w_;
+  std::string path_;
+  uint64_t    cycle_ = 0;
+  void run();
+};
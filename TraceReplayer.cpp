@@ -0,0 +1,99 @@
+#include "TraceReplayer.h"
+#include <iostream>
+
+PixelTraceReplayer::PixelTraceReplayer(sc_core::sc_module_name name, const std::string& path)
+: sc_module(name), clk("clk"), pix_out("pix_out"), valid_out("valid_out"), vsync_out("vsync_out") {
+  ok_ = r_.open(path) && r_.kind() == TRACE_PIXEL;
+  if (!ok_) std::cerr << "[TRACE] '" << path << "' is not a pixel-stream trace\n";
+  else have_ = r_.next(rec_cycle_, flags_, payload_);
+  SC_CTHREAD(run, clk.pos());
+}
+
+void PixelTraceReplayer::run() {
+  pix_out.write(0);
+  valid_out.write(false);
+  vsync_out.write(false);
+  for (;;) {
+    const uint64_t want = cycle_ + 1;     // sampled downstream at the next edge
+    if (!r_.sync(want)) lost();
+    if (!have_) have_ = r_.next(rec_cycle_, flags_, payload_);   // ring: may arrive later
+    while (have_ && rec_cycle_ < want) have_ = r_.next(rec_cycle_, flags_, payload_);
+    if (have_ && rec_cycle_ == want) {
+      if (flags_ & TRACE_VALID) pix_out.write(payload_[0]);
+      valid_out.write((flags_ & TRACE_VALID) != 0);
+      vsync_out.write((flags_ & TRACE_LAST) != 0);
+      ++replayed_;
+      have_ = r_.next(rec_cycle_, flags_, payload_);
+    } else {
+      valid_out.write(false);
+      vsync_out.write(false);
+    }
+    ++cycle_;
+    wait();
+  }
+}
+
+void PixelTraceReplayer::lost() {
+  if (lost_) return;
+  lost_ = true;
+  std::cerr << "[TRACE] Front-end process ended before cycle " << cycle_ + 1 << "; stopping\n";
+  sc_core::sc_stop();
+}
+
+void PixelTraceReplayer::report() const {
+  std::cout << "[TRACE] replayed " << replayed_ << " pixel records"
+            << (have_ ? " (trace not exhausted)" : "") << "\n";
+}
+
+BusTraceReplayer::BusTraceReplayer(sc_core::sc_module_name name, const std::string& path)
+: sc_module(name), clk("clk"), data_out("data_out"), valid_out("valid_out"), last_out("last_out"),
+  ready_in("ready_in") {
+  ok_ = r_.open(path) && r_.kind() == TRACE_BUS256;
+  if (!ok_) std::cerr << "[TRACE] '" << path << "' is not a 256-bit bus trace\n";
+  else have_ = r_.next(rec_cycle_, flags_, payload_);
+  SC_CTHREAD(run, clk.pos());
+}
+
+void BusTraceReplayer::run() {
+  valid_out.write(false);
+  last_out.write(false);
+  for (;;) {
+    // next beat is due when its (slipped) cycle is sampled at the next edge
+    if (!r_.sync(cycle_ + 1)) lost();
+    if (!have_) have_ = r_.next(rec_cycle_, flags_, payload_);
+    if (!hold_ && have_ && rec_cycle_ + slip_ <= cycle_ + 1) {
+      for (int i = 0; i < 8; ++i) {
+        const uint32_t w = (uint32_t)payload_[4*i] | ((uint32_t)payload_[4*i+1] << 8) |
+                           ((uint32_t)payload_[4*i+2] << 16) | ((uint32_t)payload_[4*i+3] << 24);
+        hold_data_.set_word(i, w);
+      }
+      hold_last_ = (flags_ & TRACE_LAST) != 0;
+      hold_      = true;
+      have_      = r_.next(rec_cycle_, flags_, payload_);
+    }
+    if (hold_) {
+      data_out.write(hold_data_);
+      valid_out.write(true);
+      last_out.write(hold_last_);
+      if (ready_in.read()) { hold_ = false; ++replayed_; }
+      else ++slip_;
+    } else {
+      valid_out.write(false);
+      last_out.write(false);
+    }
+    ++cycle_;
+    wait();
+  }
+}
+
+void BusTraceReplayer::lost() {
+  if (lost_) return;
+  lost_ = true;
+  std::cerr << "[TRACE] Front-end process ended before cycle " << cycle_ + 1 << "; stopping\n";
+  sc_core::sc_stop();
+}
+
+void BusTraceReplayer::report() const {
+  std::cout << "[TRACE] replayed " << replayed_ << " beats (slip " << slip_ << " cycles)"
+            << (have_ || hold_ ? " (trace not exhausted)" : "") << "\n";
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <systemc>
+#include <string>
+#include "StreamTrace.h"
+
+// Drivers for --replay=: re-create a recorded interface cycle for cycle so
+// the upstream modules need not be elaborated. A record sampled at edge c is
+// driven at edge c-1, like the original producer. With a "shm:" source the
+// records come live from the front-end process and each edge first waits
+// for it to have sampled the cycle being driven.
+
+// 8-bit pixel stream (no backpressure: exact cycles)
+struct PixelTraceReplayer : sc_core::sc_module {
+  sc_core::sc_in<bool>                 clk;
+  sc_core::sc_out< sc_dt::sc_uint<8> > pix_out;
+  sc_core::sc_out<bool>                valid_out;
+  sc_core::sc_out<bool>                vsync_out;
+
+  SC_HAS_PROCESS(PixelTraceReplayer);
+  PixelTraceReplayer(sc_core::sc_module_name name, const std::string& path);
+  bool ok() const { return ok_ && !lost_; }
+  const ShmRing* ring() const { return r_.ring(); }   // --split source, else null
+  void report() const;
+
+private:
+  TraceReader r_;
+  bool     ok_ = false, have_ = false, lost_ = false;
+  uint64_t rec_cycle_ = 0, cycle_ = 0, replayed_ = 0;
+  uint8_t  flags_ = 0, payload_[32];
+  void run();
+  void lost();                         // ring producer went away
+};
+
+// 256-bit bus: beats keep their recorded spacing; a beat the sink does not
+// accept is held (packer handshake) and the rest of the trace slips.
+struct BusTraceReplayer : sc_core::sc_module {
+  sc_core::sc_in<bool>                 clk;
+  sc_core::sc_out< sc_dt::sc_bv<256> > data_out;
+  sc_core::sc_out<bool>                valid_out;
+  sc_core::sc_out<bool>                last_out;
+  sc_core::sc_in<bool>                 ready_in;
+
+  SC_HAS_PROCESS(BusTraceReplayer);
+  BusTraceReplayer(sc_core::sc_module_name name, const std::string& path);
+  bool ok() const { return ok_ && !lost_; }
+  const ShmRing* ring() const { return r_.ring(); }   // --split source, else null
+  uint64_t slip() const { return slip_; }
+  void report() const;
+
+private:
+  TraceReader r_;
+  bool     ok_ = false, have_ = false, hold_ = false, hold_last_ = false, lost_ = false;
+  uint64_t rec_cycle_ = 0, cycle_ = 0, slip_ = 0, replayed_ = 0;
+  uint8_t  flags_ = 0, payload_[32];
+  sc_dt::sc_bv<256> hold_data_;
+  void run();
+  void lost();
+};
@@ -0,0 +1,237 @@
+#include "TrafficGen256.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+static uint64_t parse_bytes(const std::string& v) {
+  uint64_t n = std::stoull(v);
+  const char s = v.empty() ? 0 : v.back();
+  if (s == 'K' || s == 'k') n <<= 10;
+  if (s == 'M' || s == 'm') n <<= 20;
+  if (s == 'G' || s == 'g') n <<= 30;
+  return n;
+}
+
+bool parse_traffic_spec(const std::string& spec, TrafficConfig& cfg) {
+  std::stringstream ss(spec);
+  std::string kv;
+  while (std::getline(ss, kv, ',')) {
+    if (kv.empty()) continue;
+    const size_t eq = kv.find('=');
+    const std::string k = kv.substr(0, eq);
+    const std::string v = (eq == std::string::npos) ? "" : kv.substr(eq + 1);
+    if (k == "pattern") {
+      if      (v == "seq")    cfg.pattern = TRAFFIC_SEQ;
+      else if (v == "rand")   cfg.pattern = TRAFFIC_RAND;
+      else if (v == "stride") cfg.pattern = TRAFFIC_STRIDE;
+      else if (v == "burst")  cfg.pattern = TRAFFIC_BURST;
+      else {
+        std::cerr << "[WARN] Unknown traffic pattern '" << v << "' (seq|rand|stride|burst)\n";
+        return false;
+      }
+    }
+    else if (k == "mix")         cfg.read_frac   = std::min(1.0, std::max(0.0, std::stod(v)));
+    else if (k == "seed")        cfg.seed        = (uint32_t)std::stoul(v);
+    else if (k == "beats")       cfg.beats       = (uint32_t)std::stoul(v);
+    else if (k == "stride")      cfg.stride      = (uint32_t)parse_bytes(v);
+    else if (k == "burst")       cfg.burst       = (uint32_t)std::stoul(v);
+    else if (k == "region")      cfg.region      = parse_bytes(v);
+    else if (k == "outstanding") cfg.outstanding = (unsigned)std::stoul(v);
+    else if (k == "act")         cfg.act_cycles  = (unsigned)std::stoul(v);
+    else if (k == "out")         cfg.csv         = v;
+    else if (k == "load") {
+      std::stringstream ls(v);
+      std::string x;
+      cfg.loads_gbps.clear();
+      while (std::getline(ls, x, ':')) if (!x.empty()) cfg.loads_gbps.push_back(std::stod(x));
+    }
+    else {
+      std::cerr << "[WARN] Unknown traffic key '" << k << "'\n";
+      return false;
+    }
+  }
+  cfg.beats       = std::max(1u, cfg.beats);
+  cfg.burst       = std::max(1u, cfg.burst);
+  cfg.stride      = std::max(32u, cfg.stride / 32 * 32);
+  cfg.region      = std::max<uint64_t>(64, cfg.region / 32 * 32);
+  cfg.outstanding = std::max(1u, cfg.outstanding);
+  return true;
+}
+
+const char* traffic_pattern_name(TrafficPattern p) {
+  switch (p) {
+    case TRAFFIC_RAND:   return "rand";
+    case TRAFFIC_STRIDE: return "stride";
+    case TRAFFIC_BURST:  return "burst";
+    default:             return "seq";
+  }
+}
+
+TrafficGen256::TrafficGen256(sc_core::sc_module_name name, const TrafficConfig& cfg)
+: sc_module(name), cfg_(cfg), rng_(cfg.seed ? cfg.seed : 1) {
+  const double peak = 32.0 * cfg_.clk_mhz * 1e6 / 1e9;   // GB/s
+  if (cfg_.loads_gbps.empty())
+    for (int i = 1; i <= 12; ++i) cfg_.loads_gbps.push_back(peak * 0.1 * i);
+  raddr_ = cfg_.region / 2 / 32 * 32;                      // reads start in the other half
+  rate_  = cfg_.loads_gbps[0] / peak;
+  SC_METHOD(step);
+  sensitive << clk.pos();
+  dont_initialize();
+}
+
+uint32_t TrafficGen256::next_rand() {
+  // xorshift32
+  rng_ ^= rng_ << 13; rng_ ^= rng_ >> 17; rng_ ^= rng_ << 5;
+  return rng_;
+}
+
+uint64_t TrafficGen256::next_addr(bool read) {
+  uint64_t& cur = read ? raddr_ : waddr_;
+  if (cfg_.pattern == TRAFFIC_RAND) {
+    const uint64_t r = ((uint64_t)next_rand() << 32) | next_rand();
+    return r % (cfg_.region / 32) * 32;
+  }
+  const uint64_t a = cur;
+  cur = (cur + (cfg_.pattern == TRAFFIC_STRIDE ? cfg_.stride : 32)) % cfg_.region;
+  return a;
+}
+
+void TrafficGen256::generate() {
+  if (gen_ >= cfg_.beats) return;
+  credit_ += rate_;
+  // burst: requests are released in clumps of 'burst' at the same average rate
+  const double need = cfg_.pattern == TRAFFIC_BURST ? (double)cfg_.burst : 1.0;
+  if (credit_ < need) return;
+  while (credit_ >= 1.0 && gen_ < cfg_.beats) {
+    const bool read = cfg_.read_frac > 0.0 && next_rand() < cfg_.read_frac * 4294967296.0;
+    (read ? rq_ : wq_).push_back(Req{ next_addr(read), cycle_ });
+    credit_ -= 1.0;
+    ++gen_;
+  }
+}
+
+static double pct(std::vector<uint32_t>& v, double p) {
+  if (v.empty()) return 0.0;
+  const size_t k = std::min(v.size() - 1, (size_t)(p * (double)v.size()));
+  std::nth_element(v.begin(), v.begin() + k, v.end());
+  return v[k];
+}
+
+void TrafficGen256::close_point() {
+  Point pt;
+  pt.offered = cfg_.loads_gbps[point_];
+  pt.wr = wlat_.size();
+  pt.rd = rlat_.size();
+  const double secs = (double)(t_end_ - t_start_ + 1) / (cfg_.clk_mhz * 1e6);
+  pt.achieved = (double)(pt.wr + pt.rd) * 32.0 / (secs * 1e9);
+  auto fill = [](std::vector<uint32_t>& v, double& avg, double& p99, double& mx) {
+    if (v.empty()) return;
+    uint64_t sum = 0;
+    for (uint32_t x : v) sum += x;
+    avg = (double)sum / v.size();
+    mx  = *std::max_element(v.begin(), v.end());
+    p99 = pct(v, 0.99);
+  };
+  fill(wlat_, pt.wr_avg, pt.wr_p99, pt.wr_max);
+  fill(rlat_, pt.rd_avg, pt.rd_p99, pt.rd_max);
+  points_.push_back(pt);
+
+  wlat_.clear(); rlat_.clear();
+  gen_ = 0; credit_ = 0.0;
+  if (++point_ < cfg_.loads_gbps.size()) {
+    rate_    = cfg_.loads_gbps[point_] / (32.0 * cfg_.clk_mhz * 1e6 / 1e9);
+    t_start_ = cycle_ + 1;
+  } else {
+    sc_core::sc_stop();
+  }
+}
+
+void TrafficGen256::step() {
+  if (point_ >= cfg_.loads_gbps.size()) return;
+  ++cycle_;
+  if (cycle_ == 1) t_start_ = cycle_;
+
+  // Write beat presented last edge is taken if wready was high (LPDDR
+  // samples the same values on this edge)
+  if (w_presented_ && wready.read()) {
+    wlat_.push_back((uint32_t)(cycle_ - wq_.front().t));
+    wq_.pop_front();
+    t_end_ = cycle_;
+  }
+  // Read data returns in request order
+  if (rvalid.read() && !rout_.empty()) {
+    const sc_dt::sc_bv<256> v = rdata.read();
+    uint64_t tag = 0;
+    for (int i = 0; i < 8; ++i) tag |= (uint64_t)v.range(8*i+7, 8*i).to_uint() << (8*i);
+    if (tag != rout_.front().addr) ++mismatches_;
+    rlat_.push_back((uint32_t)(cycle_ - rout_.front().t));
+    rout_.pop_front();
+    t_end_ = cycle_;
+  }
+
+  generate();
+
+  // Point complete once every request of it has finished
+  if (gen_ >= cfg_.beats && wq_.empty() && rq_.empty() && rout_.empty()) {
+    wvalid.write(false);
+    rready.write(false);
+    w_presented_ = false;
+    close_point();
+    return;
+  }
+
+  // Drive the head write beat (held until accepted)
+  w_presented_ = !wq_.empty();
+  if (w_presented_) {
+    const uint64_t a = wq_.front().addr;
+    sc_dt::sc_bv<256> d;
+    for (int i = 0; i < 8; ++i) d.range(8*i+7, 8*i) = sc_dt::sc_bv<8>((unsigned)((a >> (8*i)) & 0xFF));
+    wdata.write(d);
+    waddr.write(a);
+  }
+  wvalid.write(w_presented_);
+  wlast.write(false);
+
+  // One read request per cycle within the outstanding limit
+  const bool req = !rq_.empty() && rout_.size() < cfg_.outstanding;
+  if (req) {
+    raddr.write(rq_.front().addr);
+    rout_.push_back(rq_.front());
+    rq_.pop_front();
+  }
+  rready.write(req);
+}
+
+void TrafficGen256::report() const {
+  const double period_ns = 1000.0 / cfg_.clk_mhz;
+  std::cout << "[TRAFFIC] pattern=" << traffic_pattern_name(cfg_.pattern)
+            << " mix=" << cfg_.read_frac << " seed=" << cfg_.seed
+            << " beats/point=" << cfg_.beats << " outstanding=" << cfg_.outstanding
+            << " peak=" << (32.0 * cfg_.clk_mhz * 1e6 / 1e9) << " GB/s\n";
+  std::cout << "[TRAFFIC] offered_GBps achieved_GBps  wr_avg_ns wr_p99_ns wr_max_ns"
+               "  rd_avg_ns rd_p99_ns rd_max_ns\n";
+  std::cout << std::fixed << std::setprecision(2);
+  for (const Point& p : points_) {
+    std::cout << "[TRAFFIC] " << std::setw(12) << p.offered << " " << std::setw(13) << p.achieved
+              << "  " << std::setw(9) << p.wr_avg * period_ns << " " << std::setw(9) << p.wr_p99 * period_ns
+              << " " << std::setw(9) << p.wr_max * period_ns
+              << "  " << std::setw(9) << p.rd_avg * period_ns << " " << std::setw(9) << p.rd_p99 * period_ns
+              << " " << std::setw(9) << p.rd_max * period_ns << "\n";
+  }
+  std::cout.unsetf(std::ios::floatfield);
+  std::cout << std::setprecision(6);
+  if (mismatches_) std::cout << "[TRAFFIC] " << mismatches_ << " read beats returned the wrong address\n";
+
+  if (!cfg_.csv.empty()) {
+    std::ofstream f(cfg_.csv);
+    if (!f) { std::cerr << "[WARN] Cannot write traffic curve '" << cfg_.csv << "'\n"; return; }
+    f << "offered_gbps,achieved_gbps,wr_beats,rd_beats,wr_avg_ns,wr_p99_ns,wr_max_ns,rd_avg_ns,rd_p99_ns,rd_max_ns\n";
+    for (const Point& p : points_)
+      f << p.offered << "," << p.achieved << "," << p.wr << "," << p.rd << ","
+        << p.wr_avg * period_ns << "," << p.wr_p99 * period_ns << "," << p.wr_max * period_ns << ","
+        << p.rd_avg * period_ns << "," << p.rd_p99 * period_ns << "," << p.rd_max * period_ns << "\n";
+    std::cout << "[TRAFFIC] Curve written to " << cfg_.csv << "\n";
+  }
+}
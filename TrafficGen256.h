@@ -0,0 +1,89 @@
+#pragma once
+#include <systemc>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+enum TrafficPattern { TRAFFIC_SEQ = 0, TRAFFIC_RAND = 1, TRAFFIC_STRIDE = 2, TRAFFIC_BURST = 3 };
+
+// Synthetic memory traffic.
+// CLI form: --traffic=pattern=seq|rand|stride|burst,mix=0.3,seed=1,
+//                     load=0.8:1.6:2.4,beats=4096,stride=4096,burst=16,
+//                     region=64M,outstanding=16,act=12,out=curve.csv
+// Each offered load (GB/s) is one sweep point of 'beats' requests; the
+// default sweep is 10%..120% of the channel peak (32 bytes per clock).
+struct TrafficConfig {
+  TrafficPattern pattern = TRAFFIC_SEQ;
+  double   read_frac   = 0.0;          // mix: fraction of requests that are reads
+  uint32_t seed        = 1;
+  std::vector<double> loads_gbps;      // offered load per point
+  uint32_t beats       = 4096;         // requests per point
+  uint32_t stride      = 4096;         // stride pattern step (bytes)
+  uint32_t burst       = 16;           // burst pattern: requests per clump
+  uint64_t region      = 64ull << 20;  // address range (bytes)
+  unsigned outstanding = 16;           // read requests in flight
+  unsigned act_cycles  = 12;           // LPDDR row activation penalty
+  double   clk_mhz     = 100.0;
+  std::string csv;                     // curve output, empty: console only
+};
+
+bool        parse_traffic_spec(const std::string& spec, TrafficConfig& cfg);
+const char* traffic_pattern_name(TrafficPattern p);
+
+// 256-bit write master and read requester driving LPDDR's traffic mode.
+// Requests arrive at the offered load (token bucket; the burst pattern
+// releases them in clumps), wait in per-direction queues and are issued one
+// write beat / one read request per cycle. Latency runs from arrival to
+// write acceptance or read data. Read data is checked against the address
+// tag LPDDR returns. After the last point the generator stops the
+// simulation.
+struct TrafficGen256 : sc_core::sc_module {
+  sc_core::sc_in<bool> clk;
+
+  sc_core::sc_out< sc_dt::sc_bv<256> > wdata;
+  sc_core::sc_out<bool>                wvalid;
+  sc_core::sc_out<bool>                wlast;
+  sc_core::sc_out<uint64_t>            waddr;
+  sc_core::sc_in<bool>                 wready;
+
+  sc_core::sc_out<bool>                rready;   // one read request per cycle (traffic mode)
+  sc_core::sc_out<uint64_t>            raddr;
+  sc_core::sc_in< sc_dt::sc_bv<256> >  rdata;
+  sc_core::sc_in<bool>                 rvalid;
+
+  SC_HAS_PROCESS(TrafficGen256);
+  TrafficGen256(sc_core::sc_module_name name, const TrafficConfig& cfg);
+
+  void report() const;                 // bandwidth / latency per offered load
+  bool ok() const { return mismatches_ == 0 && point_ >= cfg_.loads_gbps.size(); }
+
+private:
+  struct Req { uint64_t addr; uint64_t t; };
+  struct Point {
+    double   offered = 0.0, achieved = 0.0;
+    uint64_t wr = 0, rd = 0;
+    double   wr_avg = 0, wr_p99 = 0, wr_max = 0;
+    double   rd_avg = 0, rd_p99 = 0, rd_max = 0;    // cycles
+  };
+
+  TrafficConfig cfg_;
+  double   rate_ = 0.0, credit_ = 0.0;             // requests per cycle
+  size_t   point_ = 0;
+  uint32_t gen_ = 0;
+  uint64_t cycle_ = 0, t_start_ = 0, t_end_ = 0;
+  uint64_t waddr_ = 0, raddr_ = 0;                 // seq / stride cursors
+  uint32_t rng_;
+  bool     w_presented_ = false;
+  uint64_t mismatches_ = 0;
+
+  std::deque<Req> wq_, rq_, rout_;                 // write queue, read queue, reads in flight
+  std::vector<uint32_t> wlat_, rlat_;              // this point
+  std::vector<Point> points_;
+
+  uint32_t next_rand();
+  uint64_t next_addr(bool read);
+  void     generate();
+  void     close_point();
+  void     step();
+};
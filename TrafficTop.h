@@ -0,0 +1,7 @@
+#pragma once
+#include "TrafficGen256.h"
+
+// Elaborates TrafficGen256 directly on LPDDR's 256-bit channels (traffic
+// mode, no sensor / ISP / packer), sweeps the offered loads and prints the
+// bandwidth and latency curve. Called from sc_main for --traffic.
+int run_traffic(const TrafficConfig& cfg);
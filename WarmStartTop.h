@@ -0,0 +1,8 @@
+#pragma once
+#include "Snapshot.h"
+
+// Memory-path-only top for a snapshot taken after the write phase: LPDDR is
+// restored with the committed frame and the run starts at the read phase
+// (no sensor, ADC, ISP, LUT or packer). Writes out.pgm and the LPDDR/read
+// sink reports. Called from sc_main for --snapshot-load= with --warm=read.
+int run_warm_read(const Snapshot& snap);
@@ -0,0 +1,72 @@
+#pragma once
+#include <systemc>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Snapshot.h"
+
+// 3A zone statistics. CLI form:
+//   --zstats=out=zones.bin,tap=adc|lut,grid=16x16,bins=16,clip=250
+struct ZoneStatsConfig {
+  std::string out;               // binary record file (one record per frame)
+  std::string tap = "lut";       // adc: ADC codes (post-LUT in fused bypass), lut: post-LUT stream
+  unsigned zones_x = 16, zones_y = 16;
+  unsigned bins    = 16;         // per-zone histogram, power of two <= 256
+  unsigned clip    = 250;        // pixel >= clip counts as clipped
+};
+
+bool parse_zone_spec(const std::string& spec, ZoneStatsConfig& cfg);
+
+// Passive tap accumulating per-zone sum/min/max/clipped/histogram, one pixel
+// per clock, with accumulators for one row of zones only: when the pixel
+// row crosses a zone boundary the finished zone row is appended to the
+// frame record and the accumulators are cleared. At vsync the record is
+// written:
+//   header: "ZSTA", u32 version=1, u32 frame, u32 W, u32 H, u32 zones_x,
+//           u32 zones_y, u32 bins, u32 clip, u64 t_ps (vsync time)
+//   zone  : u64 sum, u32 count, u32 clipped, u8 min, u8 max, u16 0,
+//           u32 hist[bins]            (zones in raster order)
+struct ZoneStats_DE : sc_core::sc_module {
+  sc_core::sc_in<bool>                clk;
+  sc_core::sc_in< sc_dt::sc_uint<8> > pix_in;
+  sc_core::sc_in<bool>                valid_in;
+  sc_core::sc_in<bool>                vsync_in;
+
+  SC_HAS_PROCESS(ZoneStats_DE);
+  ZoneStats_DE(sc_core::sc_module_name name, int W, int H, const ZoneStatsConfig& cfg);
+
+  bool ok() const { return out_.is_open(); }
+  size_t record_bytes() const { return 44 + (size_t)cfg_.zones_x * cfg_.zones_y * zone_bytes(); }
+  void report() const;
+
+private:
+  struct Acc { uint64_t sum = 0; uint32_t count = 0, clipped = 0; uint8_t mn = 255, mx = 0; };
+
+  const int W_, H_;
+  ZoneStatsConfig cfg_;          // grid clamped to the frame
+  unsigned bin_shift_ = 4;
+  std::vector<uint32_t> col_bound_, row_bound_;   // zone edges (zones + 1 entries)
+
+  // One row of zone accumulators
+  std::vector<Acc>      acc_;
+  std::vector<uint32_t> hist_;                    // zones_x * bins
+  SnapBuf               rec_;                     // finished zone rows of this frame
+
+  // Raster position
+  uint32_t col_ = 0, row_ = 0, zx_ = 0, zy_ = 0;
+  bool     prev_vs_ = false, row_dirty_ = false;
+
+  // Rate check
+  unsigned last_zx_ = ~0u, last_bin_ = ~0u;
+  uint64_t frames_ = 0, pixels_ = 0, hazards_ = 0;
+  uint64_t cycle_ = 0, frame_c0_ = 0, active_cycles_ = 0;
+  bool     in_frame_ = false;
+
+  std::ofstream out_;
+
+  size_t zone_bytes() const { return 20 + 4 * (size_t)cfg_.bins; }
+  void step();
+  void flush_zone_row();
+  void end_frame();
+};
@@ -4,9 +4,13 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <memory>
+#include <cstdlib>
+#include <unistd.h>   // getpid (--split ring name)
 
 #include "Sensor.h"             // cmos_sensor (TDF analog source)
 #include "CannyEdgeWrapper.h"   // TDF A/D + 1D LUT + DE bridge (now emits exact W*H)
+#include "DigitalSensor_DE.h"   // DE-only sensor + ADC (no AMS cluster)
 #include "BurstPacker.h"        // packs 32 bytes -> sc_bv<256>
 #include "LPDDR.h"              // NEW: bidirectional 256b LPDDR model
 #include "PcieDMA_Tap.h"        // NEW: passive throughput monitor
@@ -14,19 +18,32 @@
 #include "BMPUtils.h"           // load_bmp_grayscale()
 #include "ISP_Canny.h"
 #include "Lut1D_DE.h"
-
-// Simple PGM writer
-static bool write_pgm(const std::string& path, int W, int H, const std::vector<uint8_t>& img) {
-    std::ofstream f(path, std::ios::binary);
-    if (!f) return false;
-    f << "P5\n" << W << " " << H << "\n255\n";
-    f.write(reinterpret_cast<const char*>(img.data()), img.size());
-    std::cout << "Wrote " << path << " (" << W << "x" << H << ")\n";
-    return true;
-}
+#include "FrameCompressor_DE.h" // optional lossless stage before the packer
+#include "FrameDecompressor256.h"
+#include "AsyncFifo.h"          // dual-clock FIFO for domain crossings
+#include "MultiCamTop.h"        // N cameras → QoS arbiter → shared LPDDR
+#include "PerfCounters.h"       // per-frame counters + bottleneck summary
+#include "BusMonitor256.h"      // windowed bandwidth on the 256b buses
+#include "Snapshot.h"           // warm-start snapshot file
+#include "WarmStartTop.h"       // LPDDR-only read phase from a snapshot
+#include "EnergyModel.h"        // toggle/command-count energy model
+#include "ToggleCounter256.h"   // bus wire activity (SIMD popcount)
+#include "TraceRecorder.h"      // --record= interface stream capture
+#include "TraceReplayer.h"      // --replay= drives a captured stream
+#include "SystemCache256.h"     // optional LLC in front of the LPDDR
+#include "Log.h"                // buffered in-simulation logging
+#include "ZoneStats_DE.h"       // 3A per-zone statistics tap
+#include "ConnectedComponents_DE.h" // edge map → component records
+#include "SensorReadout.h"      // ROI / binning / skipping readout
+#include "DmaDescriptor.h"      // 2D strided / tiled LPDDR layout
+#include "TrafficTop.h"         // synthetic traffic on the memory path
+#include "IntegrityChecker256.h" // streaming CRC32C on both 256b buses
+#include "ShmRing.h"            // two-process split over shared memory
+#include "SensorFifo_DE.h"      // elastic FIFO after the ADC
 
 int sc_main(int argc, char** argv) {
     auto starts_with = [](const std::string& s, const char* p){ return s.rfind(p,0)==0; };
+    struct LogStop { ~LogStop() { Log::stop(); } } log_stop;   // drain on every return path
 
     // -------- CLI --------
     std::string bmp_path;
@@ -38,6 +55,58 @@ int sc_main(int argc, char** argv) {
     std::string hist_in_dump;
     std::string hist_out_dump;
     bool bypass_isp = false;
+    bool fuse_bypass = true;   // bypass: fold both LUTs into the wrapper
+    bool digital_sensor = false;  // DE-only sensor source instead of the AMS pair
+    FrameCodecMode codec = CODEC_OFF;
+    // Clock domains (MHz). Any --clk-* option enables the async FIFO crossings.
+    double isp_mhz = 100.0, fab_mhz = 100.0, mem_mhz = 100.0;
+    unsigned fifo_depth = 16, fifo_sync = 2;
+    bool cdc = false;
+    std::string perf_path;   // per-frame counters (JSONL, or CSV by extension)
+    std::string busmon_win;  // e.g. 1us: bandwidth windows on the write/read buses
+    std::string busmon_dump; // <prefix>[.bin]: per-window samples, one file per bus
+    // Snapshots: save after the run, load to warm-start (read phase or next frame)
+    std::string snap_save, snap_load, warm_mode = "read";
+    bool snap_isp = false;
+    bool energy_on = false;
+    std::string energy_cfg;  // per-event coefficients (key = value, pJ)
+    // Logging: level filter (ISP_LOG env, overridden by --log=), sink, timestamps
+    std::string log_path;
+    bool log_time = false;
+    if (const char* v = std::getenv("ISP_LOG"))
+        if (!Log::configure(v)) std::cerr << "[WARN] Bad ISP_LOG '" << v << "'\n";
+    bool integrity_on = false; // CRC32C digests at the packer output and read-sink input
+    IntegrityOptions integ;
+    bool traffic_on = false; // synthetic traffic sweep instead of the pipeline
+    TrafficConfig traffic_cfg;
+    bool dma_on = false;     // 2D descriptor for the LPDDR frame region
+    DmaConfig dma_cfg;
+    bool readout_on = false; // sensor ROI / bin / skip readout mode
+    ReadoutMode ro_mode;
+    bool zstats_on = false;  // 3A zone statistics on the ADC or LUT stream
+    ZoneStatsConfig zcfg;
+    bool ccl_on = false;     // component records to LPDDR instead of the edge map
+    uint32_t ccl_min = 1;
+    bool cache_on = false;   // shared last-level cache on both LPDDR channels
+    bool sfifo_on = false;   // elastic FIFO between the ADC and its consumer
+    SensorFifoConfig sfifo_cfg;
+    CacheConfig cache_cfg;
+    // Interface traces, <tap>:<file> with tap = adc|isp|wbus. Replay drops
+    // every module upstream of the tap.
+    std::vector< std::pair<std::string, std::string> > records;
+    std::string replay_tap, replay_path;
+    // Two-process split at a tap: this process keeps the back end and
+    // spawns the front end (--split-front=<ring> marks that child)
+    std::string split_tap, split_front;
+    auto parse_tap = [](const std::string& s, std::string& tap, std::string& path) {
+        const size_t c = s.find(':');
+        if (c == std::string::npos) return false;
+        tap = s.substr(0, c); path = s.substr(c + 1);
+        return (tap == "adc" || tap == "isp" || tap == "wbus") && !path.empty();
+    };
+    // Multi-camera top (one --cam= per pipeline)
+    std::vector<CameraConfig> cams;
+    MultiCamOptions mc;
 
     for (int i=1; i<argc; ++i) {
         std::string a = argv[i];
@@ -49,10 +118,124 @@ int sc_main(int argc, char** argv) {
         else if (starts_with(a,"--dump-hist-in="))  hist_in_dump  = a.substr(15);
         else if (starts_with(a,"--dump-hist-out=")) hist_out_dump = a.substr(16);
         else if (a == "--bypass-isp")          bypass_isp = true;
+        else if (a == "--no-fuse")             fuse_bypass = false;
+        else if (a == "--digital-sensor")      digital_sensor = true;
+        else if (starts_with(a,"--compress=")) {
+            if (!parse_codec_mode(a.substr(11), codec))
+                std::cerr << "[WARN] Unknown codec '" << a.substr(11) << "' (off|bitplane|rle)\n";
+        }
+        else if (starts_with(a,"--clk-isp="))    { isp_mhz = std::stod(a.substr(10)); cdc = true; }
+        else if (starts_with(a,"--clk-fabric=")) { fab_mhz = std::stod(a.substr(13)); cdc = true; }
+        else if (starts_with(a,"--clk-mem="))    { mem_mhz = std::stod(a.substr(10)); cdc = true; }
+        else if (starts_with(a,"--fifo-depth=")) fifo_depth = (unsigned)std::stoul(a.substr(13));
+        else if (starts_with(a,"--fifo-sync="))  fifo_sync  = (unsigned)std::stoul(a.substr(12));
+        else if (starts_with(a,"--perf="))       perf_path = a.substr(7);
+        else if (starts_with(a,"--busmon="))     busmon_win  = a.substr(9);
+        else if (starts_with(a,"--busmon-dump=")) busmon_dump = a.substr(14);
+        else if (starts_with(a,"--snapshot-save=")) snap_save = a.substr(16);
+        else if (starts_with(a,"--snapshot-load=")) snap_load = a.substr(16);
+        else if (a == "--snapshot-isp")              snap_isp  = true;
+        else if (starts_with(a,"--warm=")) {
+            warm_mode = a.substr(7);
+            if (warm_mode != "read" && warm_mode != "frame")
+                std::cerr << "[WARN] Unknown warm mode '" << warm_mode << "' (read|frame)\n";
+        }
+        else if (a == "--energy")                energy_on = true;
+        else if (starts_with(a,"--energy="))     { energy_on = true; energy_cfg = a.substr(9); }
+        else if (starts_with(a,"--log=")) {
+            if (!Log::configure(a.substr(6)))
+                std::cerr << "[WARN] Bad log filter '" << a.substr(6) << "' (level[,cat=level...])\n";
+        }
+        else if (starts_with(a,"--log-file="))   log_path = a.substr(11);
+        else if (a == "--log-time")              log_time = true;
+        else if (a == "--integrity")             integrity_on = true;
+        else if (starts_with(a,"--integrity="))  integrity_on = parse_integrity_spec(a.substr(12), integ);
+        else if (a == "--traffic")               traffic_on = true;
+        else if (starts_with(a,"--traffic="))    traffic_on = parse_traffic_spec(a.substr(10), traffic_cfg);
+        else if (starts_with(a,"--dma="))        dma_on = parse_dma_spec(a.substr(6), dma_cfg);
+        else if (starts_with(a,"--readout=")) {
+            // a bad spec must not leave a half-parsed mode behind
+            ReadoutMode m;
+            readout_on = parse_readout_spec(a.substr(10), m);
+            ro_mode = readout_on ? m : ReadoutMode();
+        }
+        else if (starts_with(a,"--zstats="))     zstats_on = parse_zone_spec(a.substr(9), zcfg);
+        else if (a == "--ccl")                   ccl_on = true;
+        else if (starts_with(a,"--ccl-min="))    { ccl_on = true; ccl_min = (uint32_t)std::stoul(a.substr(10)); }
+        else if (a == "--cache")                 cache_on = true;
+        else if (a == "--sensor-fifo")           sfifo_on = true;
+        else if (starts_with(a,"--sensor-fifo=")) sfifo_on = parse_sensor_fifo_spec(a.substr(14), sfifo_cfg);
+        else if (starts_with(a,"--cache="))      cache_on = parse_cache_spec(a.substr(8), cache_cfg);
+        else if (starts_with(a,"--record=")) {
+            std::string tap, path;
+            if (parse_tap(a.substr(9), tap, path)) records.emplace_back(tap, path);
+            else std::cerr << "[WARN] Bad record spec '" << a.substr(9) << "' (adc|isp|wbus:<file>)\n";
+        }
+        else if (starts_with(a,"--replay=")) {
+            if (!parse_tap(a.substr(9), replay_tap, replay_path)) {
+                std::cerr << "[WARN] Bad replay spec '" << a.substr(9) << "' (adc|isp|wbus:<file>)\n";
+                replay_tap.clear();
+            }
+        }
+        else if (starts_with(a,"--split=")) {
+            split_tap = a.substr(8);
+            if (split_tap != "adc" && split_tap != "isp" && split_tap != "wbus") {
+                std::cerr << "[WARN] Bad split tap '" << split_tap << "' (adc|isp|wbus)\n";
+                split_tap.clear();
+            }
+        }
+        else if (starts_with(a,"--split-front=")) split_front = a.substr(14);
+        else if (starts_with(a,"--cam=")) {
+            CameraConfig c;
+            if (parse_camera_spec(a.substr(6), c)) cams.push_back(c);
+        }
+        else if (starts_with(a,"--arb=")) {
+            if (!parse_arb_policy(a.substr(6), mc.policy))
+                std::cerr << "[WARN] Unknown arbiter policy '" << a.substr(6) << "' (rr|wrr|prio)\n";
+        }
+        else if (starts_with(a,"--arb-interval=")) mc.issue_interval = (unsigned)std::stoul(a.substr(15));
+        else if (starts_with(a,"--arb-queue="))    mc.queue_depth    = (unsigned)std::stoul(a.substr(12));
+        else if (starts_with(a,"--arb-starve="))   mc.starve_cycles  = (unsigned)std::stoul(a.substr(13));
         else if (!a.empty() && a[0] != '-')    bmp_path = a;
         else std::cerr << "[WARN] Unknown option: " << a << "\n";
     }
 
+    // Simulation-time messages go through the ring from here on
+    if (!split_front.empty()) {
+        // the front end keeps its own log; every other per-run output file
+        // belongs to the back end (the only record left is the shm: one)
+        if (!log_path.empty()) log_path += ".front";
+        perf_path.clear();
+        busmon_dump.clear();
+        records.clear();
+        zstats_on = false;
+        integ.write.clear();
+        snap_save.clear();
+        lut_dump.clear();
+        hist_in_dump.clear();
+        hist_out_dump.clear();
+    }
+    auto start_log = [&]{
+        if (!Log::start(log_path, log_time))
+            std::cerr << "[WARN] Cannot open log file '" << log_path << "', using stdout\n";
+    };
+    if (!cams.empty()) { start_log(); return run_multicam(cams, mc); }
+    if (traffic_on) {
+        traffic_cfg.clk_mhz = mem_mhz;
+        start_log();
+        return run_traffic(traffic_cfg);
+    }
+
+    Snapshot warm;
+    if (!snap_load.empty()) {
+        if (!warm.load(snap_load)) {
+            std::cerr << "Failed to load snapshot '" << snap_load << "'.\n";
+            return 1;
+        }
+        if (warm_mode != "frame") { start_log(); return run_warm_read(warm); }
+        std::cout << "[SNAP] Warm start of the next frame from '" << snap_load << "'\n";
+    }
+
     // -------- Image load --------
     int W = 32, H = 32;
     std::vector<uint8_t> image;
@@ -66,23 +249,116 @@ int sc_main(int argc, char** argv) {
         for (int i = 0; i < W*H; ++i) image[i] = static_cast<uint8_t>(i % 256);
     }
 
+    // Readout mode: the rest of the pipeline sees only the read-out geometry
+    SensorReadout readout;
+    if (!readout.configure(ro_mode, W, H)) {
+        std::cerr << "Readout mode does not fit the " << W << "x" << H << " array.\n";
+        return 1;
+    }
+    if (readout_on && !readout.full()) {
+        std::cout << "[SENSOR] Readout " << W << "x" << H << " -> " << readout.out_w() << "x" << readout.out_h()
+                  << " (roi " << (ro_mode.roi_w ? ro_mode.roi_w : W) << "x" << (ro_mode.roi_h ? ro_mode.roi_h : H)
+                  << "+" << ro_mode.roi_x << "+" << ro_mode.roi_y << ", bin " << ro_mode.bin_x << "x" << ro_mode.bin_y
+                  << ", skip " << ro_mode.skip_x << "x" << ro_mode.skip_y << ", "
+                  << (100.0 * readout.samples() / ((double)W * H)) << "% of pixels)\n";
+        W = readout.out_w(); H = readout.out_h();
+    }
+
+    auto mhz_period = [](double mhz){ return sc_core::sc_time(1000.0 / mhz, sc_core::SC_NS); };
+    const sc_core::sc_time isp_period = mhz_period(isp_mhz);
+
+    // -------- Two-process split: front end in a child over a shared-memory ring --------
+    // The split taps carry no backpressure, so the back end only waits on
+    // the front end and both kernels see the single-process cycles.
+    std::unique_ptr<ShmRing> split_ring;
+    const bool split_back = !split_tap.empty() && split_front.empty();
+    if (split_back) {
+        if (!replay_tap.empty()) {
+            std::cerr << "--split cannot be combined with --replay.\n";
+            return 1;
+        }
+        if (split_tap == "wbus" && (cdc || cache_on)) {
+            std::cerr << "--split=wbus needs a write bus without backpressure (no --clk-*/--cache).\n";
+            return 1;
+        }
+        if (split_tap == "isp" && bypass_isp) {
+            std::cerr << "--split=isp: nothing drives the ISP tap with --bypass-isp.\n";
+            return 1;
+        }
+        if (split_tap == "adc" && bypass_isp && fuse_bypass) {
+            std::cerr << "--split=adc: the fused bypass LUT lives in the ADC; add --no-fuse.\n";
+            return 1;
+        }
+        const std::string ring = "/isp_split_" + std::to_string(getpid());
+        const TraceKind kind = split_tap == "wbus" ? TRACE_BUS256 : TRACE_PIXEL;
+        split_ring = ShmRing::create(ring, kind, (uint64_t)(isp_period.to_seconds() * 1e12 + 0.5));
+        if (!split_ring) {
+            std::cerr << "Cannot create shared-memory ring '" << ring << "'.\n";
+            return 1;
+        }
+        const pid_t pid = spawn_self(argc, argv, "--split-front=" + ring);
+        if (pid < 0) {
+            std::cerr << "Cannot start the front-end process.\n";
+            return 1;
+        }
+        split_ring->watch_producer(pid);
+        std::cout << "[SPLIT] Front end (pid " << pid << ") → " << split_tap << " tap → back end (pid "
+                  << getpid() << ") over " << ring << "\n";
+        replay_tap  = split_tap;
+        replay_path = "shm:" + ring;
+    }
+    const bool front_only = !split_front.empty();   // the spawned front end
+    if (front_only) records.emplace_back(split_tap, "shm:" + split_front);
+
+    // Replay: which stages upstream of the tap are elaborated
+    const bool replay_adc  = replay_tap == "adc";
+    const bool replay_isp  = replay_tap == "isp";
+    const bool replay_wbus = replay_tap == "wbus";
+    const bool need_sensor = replay_tap.empty();
+    const bool need_isp    = (need_sensor || replay_adc) && !(front_only && split_tap == "adc");
+    const bool need_pixels = !replay_wbus && !(front_only && split_tap != "wbus");  // LUT / compressor / packer
+    if (replay_isp && bypass_isp) {
+        std::cerr << "[WARN] --replay=isp drives the ISP output; --bypass-isp ignored\n";
+        bypass_isp = false;
+    }
+    for (const auto& rec : records) {
+        if ((rec.first == "adc" && !need_sensor) || (rec.first == "isp" && !need_isp) ||
+            (rec.first == "wbus" && !need_pixels) || (rec.first == "isp" && bypass_isp))
+            std::cerr << "[WARN] Nothing drives the '" << rec.first << "' tap in this run; trace will be empty\n";
+    }
+
     // -------- Modules --------
-    cmos_sensor      sensor ("sensor",  image);   // TDF analog source (double samples)
-    CannyEdgeWrapper wrapper("wrapper", W, H);    // TDF A/D + 1D LUT + DE bridge
-    ISP_Canny        isp    ("isp",     W, H);    // Verilated Canny (lab10)
-    Lut1D_DE         lut    ("lut");              // post-ISP 1D LUT (DE)
-    BurstPacker      packer ("packer");           // packs 32 pixels -> 256b burst
+    // Sensor + ADC: TDF analog source and A/D wrapper, or the DE-only source
+    std::unique_ptr<cmos_sensor>      sensor;    // TDF analog source (double samples)
+    std::unique_ptr<CannyEdgeWrapper> wrapper;   // TDF A/D + 1D LUT + DE bridge
+    std::unique_ptr<DigitalSensor_DE> dsensor;   // same samples, pure DE
+    std::unique_ptr<ISP_Canny>          isp;     // Verilated Canny (lab10)
+    std::unique_ptr<FrameCompressor_DE> cmp;     // optional bitplane/RLE encoder
+    std::unique_ptr<BurstPacker>        packer;  // packs 32 pixels -> 256b burst
     LPDDR            dram   ("lpddr");            // NEW: 256b write+read LPDDR
     PcieDMA_Tap      dma    ("pcie_dma");         // NEW: passive throughput monitor
     ReadSink256      rsink  ("read_sink");        // NEW: consumes read stream
+    FrameDecompressor256 decomp("decompress");    // decodes the read stream
 
     // -------- Signals --------
-    sca_tdf::sca_signal<double>     analog_sig;
-    sc_core::sc_clock               clk("clk", sc_core::sc_time(10, sc_core::SC_NS));
+    std::unique_ptr< sca_tdf::sca_signal<double> > analog_sig;
+    sc_core::sc_clock               clk("clk", isp_period);   // sensor/ISP domain
+
+    // Fabric (packer, DMA, read sink) and LPDDR domains share clk unless split
+    std::unique_ptr<sc_core::sc_clock> clk_fab_own, clk_mem_own;
+    if (cdc) {
+      clk_fab_own.reset(new sc_core::sc_clock("clk_fab", mhz_period(fab_mhz)));
+      clk_mem_own.reset(new sc_core::sc_clock("clk_mem", mhz_period(mem_mhz)));
+    }
+    sc_core::sc_clock& clk_fab = cdc ? *clk_fab_own : clk;
+    sc_core::sc_clock& clk_mem = cdc ? *clk_mem_own : clk;
 
     // ADC → ISP signals
     sc_core::sc_signal< sc_dt::sc_uint<8> > adc_pix;
     sc_core::sc_signal<bool>                adc_vld, adc_hs, adc_vs;
+    // Sensor → elastic FIFO (--sensor-fifo), which then drives adc_*
+    sc_core::sc_signal< sc_dt::sc_uint<8> > sen_pix;
+    sc_core::sc_signal<bool>                sen_vld, sen_vs, sfifo_ready;
 
     // ISP → LUT signals
     sc_core::sc_signal< sc_dt::sc_uint<8> > isp_pix;
@@ -92,9 +368,18 @@ int sc_main(int argc, char** argv) {
     sc_core::sc_signal< sc_dt::sc_uint<8> > lut_pix;
     sc_core::sc_signal<bool>                lut_vld, lut_vs;
 
+    // Connected components → compressor/packer signals
+    sc_core::sc_signal< sc_dt::sc_uint<8> > ccl_pix;
+    sc_core::sc_signal<bool>                ccl_vld, ccl_vs;
+
+    // Compressor → packer signals
+    sc_core::sc_signal< sc_dt::sc_uint<8> > cmp_pix;
+    sc_core::sc_signal<bool>                cmp_vld, cmp_vs;
+
     // 256-bit bus
     sc_core::sc_signal< sc_dt::sc_bv<256> > wdata_bus;
-    sc_core::sc_signal<bool>                wvalid_sig, wready_sig;
+    sc_core::sc_signal<bool>                wvalid_sig, wready_sig, wlast_sig;
+    sc_core::sc_signal< sc_dt::sc_uint<8> > wid_sig;   // single stream: id 0
 
     // LPDDR read bus
     sc_core::sc_signal< sc_dt::sc_bv<256> > rdata_bus;
@@ -103,109 +388,493 @@ int sc_main(int argc, char** argv) {
     // dummy sink to satisfy any ready_out debug port
     sc_core::sc_signal<bool>                packer_ready_sink;
 
-    // -------- AMS → DE wiring --------
-    sensor.out(analog_sig);
-
-    wrapper.analog_in(analog_sig);
-    wrapper.pixel_out(adc_pix);
-    wrapper.valid_out(adc_vld);
-    wrapper.hsync_out(adc_hs);
-    wrapper.vsync_out(adc_vs);
-
-    // ---------- ISP always bound ----------
-isp.clk(clk);
-isp.pix_in(adc_pix);
-isp.valid_in(adc_vld);
-isp.vsync_in(adc_vs);
-isp.pix_out(isp_pix);
-isp.valid_out(isp_vld);
-isp.vsync_out(isp_vs);
-
-// ---------- LUT clock ----------
-lut.clk(clk);
-
-// ---------- Select ISP vs bypass feeding the LUT ----------
-if (!bypass_isp) {
-    std::cout << "[PIPE] ISP in-path (ADC → ISP → LUT)\n";
-    lut.pix_in(isp_pix);
-    lut.valid_in(isp_vld);
-    lut.vsync_in(isp_vs);
-} else {
-    std::cout << "[PIPE] ISP bypass ENABLED (ADC → LUT)\n";
-    lut.pix_in(adc_pix);
-    lut.valid_in(adc_vld);
-    lut.vsync_in(adc_vs);
-}
+    // Clock-domain crossing signals (only bound when cdc is enabled)
+    sc_core::sc_signal< sc_dt::sc_uint<8> > fab_pix;          // ISP → fabric pixel stream
+    sc_core::sc_signal<bool>                fab_vld, fab_vs, pfifo_ready_nc;
+    sc_core::sc_signal< sc_dt::sc_bv<256> > mem_wdata;        // fabric → LPDDR write bus
+    sc_core::sc_signal<bool>                mem_wvalid, mem_wready, mem_wlast;
+
+    // Cache → LPDDR signals (only bound with --cache)
+    sc_core::sc_signal< sc_dt::sc_bv<256> > llc_wdata, llc_rdata;
+    sc_core::sc_signal<bool>                llc_wvalid, llc_wready, llc_wlast, llc_rvalid, llc_rready;
+    sc_core::sc_signal< sc_dt::sc_bv<256> > fab_rdata;        // LPDDR → fabric read bus
+    sc_core::sc_signal<bool>                fab_rvalid, fab_rready, rlast_nc, fab_rlast_nc;
+
+    // -------- Sensor → ADC → DE wiring --------
+    std::unique_ptr<PixelTraceReplayer> pix_replay;
+    std::unique_ptr<BusTraceReplayer>   bus_replay;
+    if (!need_sensor) {
+      std::cout << "[PIPE] Replaying '" << replay_path << "' at the " << replay_tap << " tap\n";
+      if (replay_wbus) {
+        bus_replay.reset(new BusTraceReplayer("replay", replay_path));
+        bus_replay->clk(clk_fab);
+        bus_replay->data_out(wdata_bus);
+        bus_replay->valid_out(wvalid_sig);
+        bus_replay->last_out(wlast_sig);
+        bus_replay->ready_in(wready_sig);
+        if (!bus_replay->ok()) return 1;
+      } else {
+        pix_replay.reset(new PixelTraceReplayer("replay", replay_path));
+        pix_replay->clk(clk);
+        pix_replay->pix_out  (replay_adc ? adc_pix : isp_pix);
+        pix_replay->valid_out(replay_adc ? adc_vld : isp_vld);
+        pix_replay->vsync_out(replay_adc ? adc_vs  : isp_vs);
+        if (!pix_replay->ok()) return 1;
+      }
+    } else if (digital_sensor) {
+      std::cout << "[PIPE] Digital sensor source (no AMS cluster)\n";
+      dsensor.reset(new DigitalSensor_DE("sensor", image, W, H));
+      dsensor->set_readout(readout);
+      dsensor->clk(clk);
+      dsensor->pixel_out(sfifo_on ? sen_pix : adc_pix);
+      dsensor->valid_out(sfifo_on ? sen_vld : adc_vld);
+      dsensor->hsync_out(adc_hs);
+      dsensor->vsync_out(sfifo_on ? sen_vs  : adc_vs);
+    } else {
+      sensor.reset(new cmos_sensor("sensor", image, isp_period));
+      sensor->set_readout(readout);
+      wrapper.reset(new CannyEdgeWrapper("wrapper", W, H, isp_period));
+      analog_sig.reset(new sca_tdf::sca_signal<double>("analog_sig"));
+      sensor->out(*analog_sig);
+
+      wrapper->analog_in(*analog_sig);
+      wrapper->pixel_out(sfifo_on ? sen_pix : adc_pix);
+      wrapper->valid_out(sfifo_on ? sen_vld : adc_vld);
+      wrapper->hsync_out(adc_hs);
+      wrapper->vsync_out(sfifo_on ? sen_vs  : adc_vs);
+    }
+    AdcFrontEnd* adc_fe = dsensor ? &dsensor->front_end() : wrapper ? &wrapper->front_end() : nullptr;
+
+    // ---------- Optional elastic FIFO after the ADC ----------
+    std::unique_ptr<SensorFifo_DE> sfifo;
+    if (sfifo_on && !need_sensor) {
+      std::cerr << "[WARN] --sensor-fifo sits behind the sensor; ignored with --replay/--split\n";
+    } else if (sfifo_on) {
+      sfifo.reset(new SensorFifo_DE("sensor_fifo", W, H, sfifo_cfg));
+      sfifo->clk(clk);
+      sfifo->pix_in(sen_pix);   sfifo->valid_in(sen_vld);   sfifo->vsync_in(sen_vs);
+      sfifo->pix_out(adc_pix);  sfifo->valid_out(adc_vld);  sfifo->vsync_out(adc_vs);
+      if (need_isp && !bypass_isp) sfifo->ready_in(sfifo_ready);   // LUT path has no backpressure
+      std::cout << "[PIPE] Sensor FIFO " << sfifo->capacity() << " px ("
+                << (sfifo_cfg.line_mode ? "line" : "pixel") << " mode, drop="
+                << (sfifo_cfg.frame_drop ? "frame" : "pixel") << ")\n";
+    }
 
-    
-    lut.pix_out(lut_pix);
-    lut.valid_out(lut_vld);
-    lut.vsync_out(lut_vs);
+    // ---------- ISP always bound (unless replayed past) ----------
+    if (need_isp) {
+      isp.reset(new ISP_Canny("isp", W, H));
+      std::cout << "[PIPE] ISP geometry " << W << "x" << H
+                << (isp->fixed_geometry() ? " (compile-time specialized)" : " (runtime)") << "\n";
+      isp->clk(clk);
+      isp->pix_in(adc_pix);
+      isp->valid_in(adc_vld);
+      isp->vsync_in(adc_vs);
+      if (sfifo && !bypass_isp) isp->ready_out(sfifo_ready);
+      isp->pix_out(isp_pix);
+      isp->valid_out(isp_vld);
+      isp->vsync_out(isp_vs);
+    }
+    if (isp && snap_isp && !snap_save.empty()) isp->keep_snapshot(true);
+    if (const std::vector<uint8_t>* sec = isp ? warm.find("ISPF") : nullptr) {
+      SnapCursor c(*sec);
+      if (isp->restore_state(c)) std::cout << "[SNAP] ISP frame buffers restored\n";
+      else std::cerr << "[WARN] Snapshot ISP buffers do not match " << W << "x" << H << ", ignored\n";
+    }
 
-    // Program the post-ISP LUT
-    lut.load_identity();
+    // -------- Program the post-ISP LUT table --------
+    Lut1DTable post_lut;
     if (!lut_path.empty()) {
-      if (!lut.load_lut_file(lut_path)) {
+      if (!post_lut.load_lut_file(lut_path)) {
         std::cerr << "[LUT] Failed to load '" << lut_path << "'. Using identity.\n";
       }
     } else {
-      if (gain  != 1.0 || offs != 0.0) lut.apply_gain_offset(gain, offs);
-      if (gamma >  0.0)                lut.apply_gamma(gamma);
+      if (gain  != 1.0 || offs != 0.0) post_lut.apply_gain_offset(gain, offs);
+      if (gamma >  0.0)                post_lut.apply_gamma(gamma);
     }
-    if (!lut_dump.empty())      (void)lut.dump_lut(lut_dump);
-    if (!hist_in_dump.empty() || !hist_out_dump.empty()) {
-      lut.enable_stats(true);
-      if (!hist_in_dump.empty())  lut.set_hist_in_dump_path(hist_in_dump);
-      if (!hist_out_dump.empty()) lut.set_hist_out_dump_path(hist_out_dump);
+    // --warm=frame: the snapshot table replaces the CLI programming. Its
+    // histograms are not restored: they were saved after the last frame's
+    // vsync reset, and the warm run counts its new frame from zero.
+    const std::vector<uint8_t>* warm_lut = warm.find("LUT1");
+    if (warm_lut) { SnapCursor c(*warm_lut); post_lut.restore_state(c); }
+    if (!lut_dump.empty())      (void)post_lut.dump_lut(lut_dump);
+    const bool want_hist = !hist_in_dump.empty() || !hist_out_dump.empty();
+
+    // -------- Select ISP vs bypass feeding the LUT --------
+    // Bypass fuses wrapper LUT + post-ISP LUT into one table inside the
+    // wrapper, so the Lut1D_DE hop and its signals are not elaborated.
+    // A replayed ADC stream has no wrapper to fold into: keep the LUT stage.
+    const bool fused = bypass_isp && fuse_bypass && adc_fe;
+    std::unique_ptr<Lut1D_DE> lut;
+    if (!need_pixels) {
+      // --replay=wbus: the bus trace already carries LUT/compressor output
+    } else if (fused) {
+      std::cout << "[PIPE] ISP bypass ENABLED, fused LUT (ADC+LUT → packer)\n";
+      adc_fe->fuse_post_lut(post_lut);
+      if (want_hist) {
+        adc_fe->fused_stats().enable(true);
+        if (!hist_in_dump.empty())  adc_fe->fused_stats().set_in_dump_path(hist_in_dump);
+        if (!hist_out_dump.empty()) adc_fe->fused_stats().set_out_dump_path(hist_out_dump);
+      }
+    } else {
+      lut.reset(new Lut1D_DE("lut"));     // post-ISP 1D LUT (DE)
+      lut->clk(clk);
+      if (!bypass_isp) {
+        std::cout << "[PIPE] ISP in-path (ADC → ISP → LUT)\n";
+        lut->pix_in(isp_pix);
+        lut->valid_in(isp_vld);
+        lut->vsync_in(isp_vs);
+      } else {
+        std::cout << "[PIPE] ISP bypass ENABLED (ADC → LUT)\n";
+        lut->pix_in(adc_pix);
+        lut->valid_in(adc_vld);
+        lut->vsync_in(adc_vs);
+      }
+      lut->pix_out(lut_pix);
+      lut->valid_out(lut_vld);
+      lut->vsync_out(lut_vs);
+      lut->set_table(post_lut);
+      if (want_hist) {
+        lut->enable_stats(true);
+        if (!hist_in_dump.empty())  lut->set_hist_in_dump_path(hist_in_dump);
+        if (!hist_out_dump.empty()) lut->set_hist_out_dump_path(hist_out_dump);
+      }
+    }
+    auto& post_pix = fused ? adc_pix : lut_pix;
+    auto& post_vld = fused ? adc_vld : lut_vld;
+    auto& post_vs  = fused ? adc_vs  : lut_vs;
+
+    // -------- 3A zone statistics (passive tap) --------
+    std::unique_ptr<ZoneStats_DE> zstats;
+    if (zstats_on) {
+      const bool at_adc = zcfg.tap == "adc";
+      if ((at_adc && !need_isp) || (!at_adc && !need_pixels))
+        std::cerr << "[WARN] Nothing drives the zone-stats '" << zcfg.tap << "' tap in this run\n";
+      if (at_adc && fused)
+        std::cout << "[ZSTATS] tap=adc sees the fused LUT output (--no-fuse for raw ADC codes)\n";
+      zstats.reset(new ZoneStats_DE("zstats", W, H, zcfg));
+      zstats->clk(clk);
+      zstats->pix_in  (at_adc ? adc_pix : post_pix);
+      zstats->valid_in(at_adc ? adc_vld : post_vld);
+      zstats->vsync_in(at_adc ? adc_vs  : post_vs);
     }
 
-    // -------- Packer / DRAM / DMA / Read sink wiring --------
-    packer.clk(clk);
-    packer.pix_in(lut_pix);
-    packer.valid_in(lut_vld);
-    packer.vsync_in(lut_vs);
-    packer.burst_out  (wdata_bus);
-    packer.burst_valid(wvalid_sig);
-    packer.burst_ready(wready_sig);
-    packer.ready_out  (packer_ready_sink); // unused
+    // -------- Optional connected-component records (edge map → segments) --------
+    std::unique_ptr<ConnectedComponents_DE> ccl;
+    if (ccl_on && codec != CODEC_OFF) {
+      std::cerr << "[WARN] --ccl sends component records; compression disabled\n";
+      codec = CODEC_OFF;
+    }
+    if (ccl_on && need_pixels) {
+      std::cout << "[PIPE] Connected components ENABLED (records → LPDDR, min " << ccl_min << " px)\n";
+      ccl.reset(new ConnectedComponents_DE("ccl", W, H, 128, ccl_min));
+      ccl->clk(clk);
+      ccl->pix_in(post_pix);
+      ccl->valid_in(post_vld);
+      ccl->vsync_in(post_vs);
+      ccl->pix_out(ccl_pix);
+      ccl->valid_out(ccl_vld);
+      ccl->vsync_out(ccl_vs);
+    }
+    auto& pre_pix = ccl_on ? ccl_pix : post_pix;
+    auto& pre_vld = ccl_on ? ccl_vld : post_vld;
+    auto& pre_vs  = ccl_on ? ccl_vs  : post_vs;
+
+    // -------- Optional compression (LUT → compressor → packer) --------
+    const uint32_t N = static_cast<uint32_t>(W*H);
+    const uint32_t dram_bytes = ccl_on ? (uint32_t)ccl_max_bytes(W, H) : codec_max_bytes(codec, N);
+    const bool raw_frame = codec == CODEC_OFF && !ccl_on;   // DRAM holds exactly W*H bytes
+    if (need_pixels) {
+      cmp.reset(new FrameCompressor_DE("compress"));
+      cmp->clk(clk);
+      cmp->pix_in(pre_pix);
+      cmp->valid_in(pre_vld);
+      cmp->vsync_in(pre_vs);
+      cmp->pix_out(cmp_pix);
+      cmp->valid_out(cmp_vld);
+      cmp->vsync_out(cmp_vs);
+      cmp->set_mode(codec);
+    }
 
-    // LPDDR write+read
-    dram.clk(clk);
-    dram.wdata(wdata_bus);
-    dram.wvalid(wvalid_sig);
-    dram.wready(wready_sig);
+    if (codec != CODEC_OFF)
+      std::cout << "[PIPE] Compression ENABLED (" << codec_mode_name(codec) << ")\n";
+    auto& src_pix = (codec == CODEC_OFF) ? pre_pix : cmp_pix;
+    auto& src_vld = (codec == CODEC_OFF) ? pre_vld : cmp_vld;
+    auto& src_vs  = (codec == CODEC_OFF) ? pre_vs  : cmp_vs;
+
+    // -------- Clock-domain crossings (ISP → fabric → LPDDR → fabric) --------
+    std::unique_ptr< AsyncFifo< sc_dt::sc_uint<8> > > pfifo;
+    std::unique_ptr< AsyncFifo< sc_dt::sc_bv<256> > > wfifo, rfifo;
+    if (cdc) {
+      std::cout << "[PIPE] Clock domains isp=" << isp_mhz << " MHz fabric=" << fab_mhz
+                << " MHz mem=" << mem_mhz << " MHz (fifo depth=" << fifo_depth
+                << " sync=" << fifo_sync << ")\n";
+      if (need_pixels) {
+        pfifo.reset(new AsyncFifo< sc_dt::sc_uint<8> >("pix_cdc", fifo_depth, fifo_sync));
+        pfifo->wclk(clk);       pfifo->rclk(clk_fab);
+        pfifo->data_in(src_pix); pfifo->valid_in(src_vld); pfifo->last_in(src_vs);
+        pfifo->ready_out(pfifo_ready_nc);            // pixel source has no backpressure
+        pfifo->set_source_honors_ready(false);
+        pfifo->data_out(fab_pix); pfifo->valid_out(fab_vld); pfifo->last_out(fab_vs);
+        pfifo->ready_in(packer_ready_sink);
+      }
+
+      wfifo.reset(new AsyncFifo< sc_dt::sc_bv<256> >("wbus_cdc", fifo_depth, fifo_sync));
+      wfifo->wclk(clk_fab);   wfifo->rclk(clk_mem);
+      wfifo->data_in(wdata_bus); wfifo->valid_in(wvalid_sig); wfifo->last_in(wlast_sig);
+      wfifo->ready_out(wready_sig);
+      wfifo->data_out(mem_wdata); wfifo->valid_out(mem_wvalid); wfifo->last_out(mem_wlast);
+      wfifo->ready_in(mem_wready);
+
+      rfifo.reset(new AsyncFifo< sc_dt::sc_bv<256> >("rbus_cdc", fifo_depth, fifo_sync));
+      rfifo->wclk(clk_mem);   rfifo->rclk(clk_fab);
+      rfifo->data_in(rdata_bus); rfifo->valid_in(rvalid_sig); rfifo->last_in(rlast_nc);
+      rfifo->ready_out(rready_sig);
+      rfifo->data_out(fab_rdata); rfifo->valid_out(fab_rvalid); rfifo->last_out(fab_rlast_nc);
+      rfifo->ready_in(fab_rready);
+    }
 
-    dram.rdata(rdata_bus);
-    dram.rvalid(rvalid_sig);
-    dram.rready(rready_sig);
+    // -------- Packer / DRAM / DMA / Read sink wiring --------
+    if (need_pixels) {
+      packer.reset(new BurstPacker("packer"));
+      packer->clk(clk_fab);
+      packer->pix_in  (cdc ? fab_pix : src_pix);
+      packer->valid_in(cdc ? fab_vld : src_vld);
+      packer->vsync_in(cdc ? fab_vs  : src_vs);
+      packer->burst_out  (wdata_bus);
+      packer->burst_valid(wvalid_sig);
+      packer->burst_last (wlast_sig);
+      packer->burst_ready(wready_sig);
+      packer->ready_out  (packer_ready_sink); // backpressure (used by the pixel CDC FIFO)
+      packer->set_registered_ready(pfifo != nullptr);
+    }
+
+    // Optional last-level cache on the LPDDR side of both channels
+    std::unique_ptr<SystemCache256> llc;
+    if (cache_on) {
+      llc.reset(new SystemCache256("llc", cache_cfg));
+      llc->clk(clk_mem);
+      llc->s_wdata (cdc ? mem_wdata  : wdata_bus);
+      llc->s_wvalid(cdc ? mem_wvalid : wvalid_sig);
+      llc->s_wlast (cdc ? mem_wlast  : wlast_sig);
+      llc->s_wready(cdc ? mem_wready : wready_sig);
+      llc->set_write_source_fifo(cdc);
+      llc->m_wdata(llc_wdata); llc->m_wvalid(llc_wvalid); llc->m_wlast(llc_wlast); llc->m_wready(llc_wready);
+      llc->m_rdata(llc_rdata); llc->m_rvalid(llc_rvalid); llc->m_rready(llc_rready);
+      llc->s_rdata(rdata_bus); llc->s_rvalid(rvalid_sig); llc->s_rready(rready_sig);
+    }
 
-    dram.set_expected_bytes(static_cast<uint32_t>(W*H));
+    // LPDDR write+read
+    dram.clk(clk_mem);
+    dram.wdata (llc ? llc_wdata  : cdc ? mem_wdata  : wdata_bus);
+    dram.wvalid(llc ? llc_wvalid : cdc ? mem_wvalid : wvalid_sig);
+    dram.wlast (llc ? llc_wlast  : cdc ? mem_wlast  : wlast_sig);
+    dram.wready(llc ? llc_wready : cdc ? mem_wready : wready_sig);
+    dram.wid(wid_sig);
+
+    dram.rdata (llc ? llc_rdata  : rdata_bus);
+    dram.rvalid(llc ? llc_rvalid : rvalid_sig);
+    dram.rready(llc ? llc_rready : rready_sig);
+
+    dram.set_expected_bytes(dram_bytes);   // capacity; wlast commits compressed size
+    if (dma_on && !raw_frame) {
+      std::cerr << "[WARN] --dma lays out the raw frame; ignored with compression or --ccl\n";
+    } else if (dma_on) {
+      DmaDescriptor desc;
+      if (!desc.configure(dma_cfg, (uint32_t)W, (uint32_t)H)) return 1;
+      std::cout << "[PIPE] 2D DMA " << desc.describe() << "\n";
+      dram.set_dma(desc);
+    }
+    if (cdc) {
+      // read FIFO must reach the sink before the LPDDR stops the simulation
+      const double drain_fab = fifo_depth + 2.0*fifo_sync + 4.0;
+      dram.set_stop_drain_cycles((unsigned)(drain_fab * mem_mhz / fab_mhz) + fifo_sync + 1
+                                 + (llc ? llc->drain_cycles() : 0));
+    } else if (llc) {
+      dram.set_stop_drain_cycles(llc->drain_cycles());   // cached read beats still in flight
+    }
     dram.reset_counters();
 
     // PCIe-DMA throughput tap (passive)
-    dma.clk(clk);
+    dma.clk(clk_fab);
     dma.data_in(wdata_bus);
     dma.valid_in(wvalid_sig);
-    dma.set_expected_bytes(static_cast<uint32_t>(W*H));
+    dma.last_in(wlast_sig);
+    dma.set_expected_bytes(raw_frame ? N : 0);
 
     // Read sink consumes DRAM read stream (drives rready=1)
-    rsink.clk(clk);
-    rsink.data_in(rdata_bus);
-    rsink.valid_in(rvalid_sig);
-    rsink.ready_out(rready_sig);
-    rsink.set_expected_bytes(static_cast<uint32_t>(W*H));
+    rsink.clk(clk_fab);
+    rsink.data_in  (cdc ? fab_rdata  : rdata_bus);
+    rsink.valid_in (cdc ? fab_rvalid : rvalid_sig);
+    rsink.ready_out(cdc ? fab_rready : rready_sig);
+    rsink.set_expected_bytes(raw_frame ? N : 0);
+
+    // -------- Optional streaming integrity taps (packer output, read-sink input) --------
+    std::unique_ptr<IntegrityChecker256> chk_wr, chk_rd;
+    sc_core::sc_signal<bool> chk_nolast;
+    if (integrity_on) {
+      chk_wr.reset(new IntegrityChecker256("chk_wbus", (uint32_t)W));
+      chk_wr->clk(clk_fab);
+      chk_wr->data_in(wdata_bus);
+      chk_wr->valid_in(wvalid_sig);
+      chk_wr->ready_in(wready_sig);
+      chk_wr->last_in(wlast_sig);
+      chk_wr->set_frame_bytes(raw_frame ? N : 0);
+      if (!integ.golden.empty()) {
+        std::vector<FrameDigest> golden;
+        if (!load_digests(integ.golden, golden)) {
+          std::cerr << "Cannot read golden digests '" << integ.golden << "'.\n";
+          return 1;
+        }
+        chk_wr->set_golden(golden);
+      }
+      chk_rd.reset(new IntegrityChecker256("chk_rbus", (uint32_t)W));
+      chk_rd->clk(clk_fab);
+      chk_rd->data_in (cdc ? fab_rdata  : rdata_bus);
+      chk_rd->valid_in(cdc ? fab_rvalid : rvalid_sig);
+      chk_rd->ready_in(cdc ? fab_rready : rready_sig);
+      chk_rd->last_in(chk_nolast);
+      if (dma_on && raw_frame && dma_cfg.order != DmaOrder::Raster)
+        std::cerr << "[WARN] --dma read order differs from the write stream; read digests not compared\n";
+      else
+        chk_rd->set_reference(chk_wr.get());
+      std::cout << "[PIPE] Integrity taps ENABLED (CRC32C per frame and per " << W << "-byte line)\n";
+    }
 
-    // -------- Go --------
-    std::cout << "Running pipeline: Sensor(AMS) → ADC → "
-              << (bypass_isp ? "(bypass ISP) " : "ISP(Canny) ")
-              << "→ 1D LUT → 256b pack → LPDDR (write + read) + PCIeDMA tap\n";
+    // Decompressor taps the read stream (reports in place of the sink)
+    decomp.clk(clk_fab);
+    decomp.data_in (cdc ? fab_rdata  : rdata_bus);
+    decomp.valid_in(cdc ? fab_rvalid : rvalid_sig);
+    decomp.set_mode(codec, N);
+
+    // -------- Interface trace recorders --------
+    std::vector< std::unique_ptr<PixelTraceRecorder> > pix_recs;
+    std::vector< std::unique_ptr<BusTraceRecorder> >   bus_recs;
+    for (const auto& rec : records) {
+      const std::string nm = "record_" + rec.first + std::to_string(pix_recs.size() + bus_recs.size());
+      if (rec.first == "wbus") {
+        bus_recs.emplace_back(new BusTraceRecorder(nm.c_str(), rec.second, clk_fab.period()));
+        BusTraceRecorder& r = *bus_recs.back();
+        r.clk(clk_fab);
+        r.data_in(wdata_bus); r.valid_in(wvalid_sig); r.ready_in(wready_sig); r.last_in(wlast_sig);
+      } else {
+        const bool at_adc = rec.first == "adc";
+        pix_recs.emplace_back(new PixelTraceRecorder(nm.c_str(), rec.second, isp_period));
+        PixelTraceRecorder& r = *pix_recs.back();
+        r.clk(clk);
+        r.pix_in  (at_adc ? adc_pix : isp_pix);
+        r.valid_in(at_adc ? adc_vld : isp_vld);
+        r.vsync_in(at_adc ? adc_vs  : isp_vs);
+      }
+    }
+
+    // -------- Performance counters --------
+    PerfCounters perf;
+    if (!perf_path.empty()) {
+      if (!perf.open(perf_path))
+        std::cerr << "[WARN] Cannot open perf log '" << perf_path << "'\n";
+      if (isp && !bypass_isp) isp->set_perf(&perf);
+      if (lut) lut->set_perf(&perf);
+      if (packer) packer->set_perf(&perf);
+      dram.set_perf(&perf);
+    }
+
+    // -------- Bus bandwidth monitors (fabric side of both 256b buses) --------
+    std::unique_ptr<BusMonitor256> wmon, rmon;
+    if (!busmon_win.empty() || !busmon_dump.empty()) {
+      // window: number + ns|us|ms (default 1us)
+      sc_core::sc_time win(1, sc_core::SC_US);
+      if (!busmon_win.empty()) {
+        size_t pos = 0;
+        const double v = std::stod(busmon_win, &pos);
+        const std::string u = busmon_win.substr(pos);
+        win = sc_core::sc_time(v, u == "ns" ? sc_core::SC_NS : u == "ms" ? sc_core::SC_MS : sc_core::SC_US);
+      }
+      wmon.reset(new BusMonitor256("wbus_mon", win));
+      wmon->clk(clk_fab);
+      wmon->valid_in(wvalid_sig);
+      wmon->ready_in(wready_sig);
+      rmon.reset(new BusMonitor256("rbus_mon", win));
+      rmon->clk(clk_fab);
+      rmon->valid_in(cdc ? fab_rvalid : rvalid_sig);
+      rmon->ready_in(cdc ? fab_rready : rready_sig);
+      if (!busmon_dump.empty()) {
+        const bool bin = busmon_dump.size() > 4 && busmon_dump.compare(busmon_dump.size() - 4, 4, ".bin") == 0;
+        const std::string stem = bin ? busmon_dump.substr(0, busmon_dump.size() - 4) : busmon_dump;
+        const char* ext = bin ? ".bin" : ".csv";
+        if (!wmon->set_dump_path(stem + "_wbus" + ext) || !rmon->set_dump_path(stem + "_rbus" + ext))
+          std::cerr << "[WARN] Cannot open bus monitor dump '" << busmon_dump << "'\n";
+      }
+    }
+
+    // -------- Energy model (bus toggles, LPDDR commands, pixel activity) --------
+    EnergyMeter energy;
+    std::unique_ptr<ToggleCounter256> wtog, rtog;
+    if (energy_on) {
+      if (!energy_cfg.empty() && !energy.coeffs.load(energy_cfg))
+        std::cerr << "[WARN] Cannot read energy coefficients '" << energy_cfg << "', using defaults\n";
+      wtog.reset(new ToggleCounter256("wbus_toggles", &energy.c.wbus_toggles));
+      wtog->data_in(wdata_bus);
+      rtog.reset(new ToggleCounter256("rbus_toggles", &energy.c.rbus_toggles));
+      rtog->data_in(cdc ? fab_rdata : rdata_bus);
+      if (lut) lut->set_energy(&energy);
+      else if (fused) adc_fe->set_lut_counter(&energy.c.lut_pix);   // the LUT lives in the ADC
+      if (packer) packer->set_energy(&energy);
+      dram.set_energy(&energy);
+    }
 
+    // -------- Go --------
+    if (replay_wbus)
+      std::cout << "Running pipeline: (replay) 256b bus → LPDDR (write + read) + PCIeDMA tap\n";
+    else
+      std::cout << "Running pipeline: " << (replay_adc ? "(replay) ADC → " : replay_isp ? "(replay) " : "Sensor(AMS) → ADC → ")
+                << (bypass_isp ? "(bypass ISP) " : "ISP(Canny) ")
+                << "→ 1D LUT → " << (codec != CODEC_OFF ? "compress → " : "")
+                << "256b pack → LPDDR (write + read) + PCIeDMA tap\n";
+
+    start_log();
     sc_core::sc_start();   // LPDDR no longer stops sim itself; we'll stop after the frame
+    Log::flush();          // buffered stage messages before the reports
+
+    if (front_only) {
+        // the back end owns the outputs; report the stages simulated here
+        std::cout << "[SPLIT] Front end stopped at " << sc_core::sc_time_stamp() << "\n";
+        if (sfifo) sfifo->report();
+        if (isp && !bypass_isp) isp->report();
+        for (const auto& r : pix_recs) r->report();
+        for (const auto& r : bus_recs) r->report();
+        return 0;
+    }
+    if (split_ring) {
+        split_ring->request_stop();
+        const int st = split_ring->reap_producer();
+        const ShmRing* rd = pix_replay ? pix_replay->ring() : bus_replay ? bus_replay->ring() : nullptr;
+        std::cout << "[SPLIT] Back end waited " << (rd ? rd->wait_seconds() : 0.0) << " s on the front end ("
+                  << (rd ? rd->waits() : 0) << " stalls); front end exit status " << st << "\n";
+        if (bus_replay && bus_replay->slip())
+            std::cerr << "[WARN] Write bus stalled " << bus_replay->slip()
+                      << " cycles; the split run no longer matches a single process\n";
+        if (st != 0 || (pix_replay && !pix_replay->ok()) || (bus_replay && !bus_replay->ok())) {
+            std::cout << "FAIL\n";
+            return 1;
+        }
+    }
 
     // Host read-back (same as before — proves content)
     std::vector<uint8_t> frame_back;
     dram.read_back(frame_back);
-    if (frame_back.size() >= static_cast<size_t>(W*H)) {
+    if (codec != CODEC_OFF) {
+        std::vector<uint8_t> packed;
+        packed.swap(frame_back);
+        if (!frame_decode(codec, packed, N, frame_back))
+            std::cerr << "[WARN] Decoding " << packed.size() << " compressed bytes came up short\n";
+    }
+    if (ccl_on) {
+        std::vector<CclComponent> comps;
+        if (!ccl_decode(frame_back, comps))
+            std::cerr << "[WARN] Component record stream from DRAM is incomplete\n";
+        if (write_components_csv("components.csv", comps))
+            std::cout << "[CCL] " << comps.size() << " components → components.csv\n";
+    } else if (frame_back.size() >= static_cast<size_t>(W*H)) {
         frame_back.resize(W*H);
         write_pgm("out.pgm", W, H, frame_back);
     } else {
@@ -213,7 +882,68 @@ if (!bypass_isp) {
                   << frame_back.size() << " < " << (W*H) << "\n";
     }
 
+    if (!snap_save.empty()) {
+        Snapshot snap;
+        snap.W = (uint32_t)W; snap.H = (uint32_t)H; snap.codec = (uint32_t)codec;
+        SnapBuf mem, tab;
+        dram.save_state(mem);
+        snap.add("LPDR", mem);
+        if (lut) lut->save_state(tab);
+        else   { post_lut.save_state(tab); if (adc_fe) adc_fe->fused_stats().save_state(tab); }
+        if (need_pixels) snap.add("LUT1", tab);
+        if (snap_isp && isp && !bypass_isp) {
+            SnapBuf ib;
+            isp->save_state(ib);
+            snap.add("ISPF", ib);
+        }
+        if (snap.save(snap_save)) std::cout << "[SNAP] Saved '" << snap_save << "'\n";
+        else std::cerr << "[WARN] Cannot write snapshot '" << snap_save << "'\n";
+    }
+
     dram.report(); // print WRITE and READ throughputs
+    if (llc) llc->report();  // hit rates, DRAM traffic saved, added latency
+    if (sfifo) sfifo->report();     // lost pixels/lines/frames, peak occupancy
+    if (zstats) zstats->report();   // zone grid, record size, pixel-rate check
+    if (ccl) ccl->report();         // components, label memory, bytes vs edge map
+    if (isp && !bypass_isp) isp->report();  // ISP frame latency vs throughput
+    if (cmp) cmp->report();  // compression ratio / DRAM bytes saved (if enabled)
+    if (!perf_path.empty()) perf.summary();   // per-stage busy time, bottleneck
+    if (wmon) { wmon->report(); rmon->report(); }   // windowed peak vs sustained bandwidth
+    if (energy_on) energy.report();                 // pJ/byte, mW, breakdown
+    for (const auto& r : pix_recs) r->report();
+    for (const auto& r : bus_recs) r->report();
+    if (pix_replay) pix_replay->report();
+    if (bus_replay) bus_replay->report();
+    if (chk_wr) {
+        chk_wr->report();
+        chk_rd->report();
+        if (!integ.write.empty()) {
+            if (save_digests(integ.write, chk_wr->digests()))
+                std::cout << "[INTEGRITY] Digests written to " << integ.write << "\n";
+            else
+                std::cerr << "[WARN] Cannot write digests '" << integ.write << "'\n";
+        }
+    }
+
+    if (cdc && pfifo) {
+      // Per-domain utilization: fraction of domain cycles carrying a transfer
+      auto pct = [](uint64_t n, uint64_t d){ return d ? 100.0 * (double)n / (double)d : 0.0; };
+      std::cout << "[CLK] isp    " << isp_mhz << " MHz cycles=" << pfifo->wcycles()
+                << " util=" << pct(pfifo->pushes(), pfifo->wcycles()) << "% (pixels out)\n";
+      std::cout << "[CLK] fabric " << fab_mhz << " MHz cycles=" << pfifo->rcycles()
+                << " util=" << pct(pfifo->pops(), pfifo->rcycles()) << "% (pixels packed) "
+                << pct(rfifo->pops(), rfifo->rcycles()) << "% (read beats)\n";
+      std::cout << "[CLK] mem    " << mem_mhz << " MHz cycles=" << wfifo->rcycles()
+                << " util=" << pct(wfifo->pops(), wfifo->rcycles()) << "% (write beats) "
+                << pct(rfifo->pushes(), rfifo->wcycles()) << "% (read beats)\n";
+      pfifo->report();
+      wfifo->report();
+      rfifo->report();
+    }
+    if (chk_wr && (!chk_wr->ok() || !chk_rd->ok())) {
+        std::cout << "FAIL\n";
+        return 1;
+    }
     std::cout << "PASS\n";
     return 0;
 }
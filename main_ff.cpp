@@ -0,0 +1,130 @@
+// isp_ff: kernel-free fast-forward executor (golden model for CI/regressions).
+// Same LUT/bypass/compress flags as isp_pipeline_ams; any number of images,
+// processed in parallel with --jobs=N (one RTL model per worker).
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FastForward.h"
+#include "BMPUtils.h"
+
+// Verilator runtime hook (no SystemC kernel in this executable)
+double sc_time_stamp() { return 0.0; }
+
+static std::string stem_of(const std::string& path) {
+  const size_t s = path.find_last_of("/\\");
+  std::string b = (s == std::string::npos) ? path : path.substr(s + 1);
+  const size_t d = b.find_last_of('.');
+  return (d == std::string::npos) ? b : b.substr(0, d);
+}
+
+int main(int argc, char** argv) {
+  auto starts_with = [](const std::string& s, const char* p){ return s.rfind(p,0)==0; };
+
+  // -------- CLI --------
+  FfOptions opt;
+  std::vector<std::string> images;
+  std::string lut_dump, hist_in_dump, hist_out_dump;
+  std::string out_dir = ".";
+  unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+
+  for (int i=1; i<argc; ++i) {
+    std::string a = argv[i];
+    if (starts_with(a,"--gamma="))         opt.gamma    = std::stod(a.substr(8));
+    else if (starts_with(a,"--gain="))     opt.gain     = std::stod(a.substr(7));
+    else if (starts_with(a,"--offset="))   opt.offs     = std::stod(a.substr(9));
+    else if (starts_with(a,"--lut="))      opt.lut_path = a.substr(6);
+    else if (starts_with(a,"--dump-lut=")) lut_dump     = a.substr(11);
+    else if (starts_with(a,"--dump-hist-in="))  hist_in_dump  = a.substr(15);
+    else if (starts_with(a,"--dump-hist-out=")) hist_out_dump = a.substr(16);
+    else if (a == "--bypass-isp")          opt.bypass_isp = true;
+    else if (starts_with(a,"--rtl=")) {
+      const std::string m = a.substr(6);
+      if (m == "full" || m == "fast") opt.rtl_fast = (m == "fast");
+      else std::cerr << "[WARN] Unknown RTL sequence '" << m << "' (full|fast)\n";
+    }
+    else if (starts_with(a,"--compress=")) {
+      if (!parse_codec_mode(a.substr(11), opt.codec))
+        std::cerr << "[WARN] Unknown codec '" << a.substr(11) << "' (off|bitplane|rle)\n";
+    }
+    else if (starts_with(a,"--jobs="))     jobs    = std::max(1ul, std::stoul(a.substr(7)));
+    else if (starts_with(a,"--out-dir="))  out_dir = a.substr(10);
+    else if (!a.empty() && a[0] != '-')    images.push_back(a);
+    else std::cerr << "[WARN] Unknown option: " << a << "\n";
+  }
+
+  // One image (or the built-in ramp) writes the same files as the SystemC run;
+  // a batch writes <out-dir>/<stem>.pgm and <stem>.<hist name> per image.
+  const bool batch = images.size() > 1;
+  if (images.empty()) images.push_back("");
+  auto out_path = [&](const std::string& img, const std::string& name) {
+    if (!batch) return name;
+    const size_t s = name.find_last_of("/\\");
+    return out_dir + "/" + stem_of(img) + "." + (s == std::string::npos ? name : name.substr(s + 1));
+  };
+
+  Lut1DTable post_lut;
+  ff_build_post_lut(opt, post_lut);
+  if (!lut_dump.empty()) (void)post_lut.dump_lut(lut_dump);
+
+  // -------- Workers --------
+  jobs = std::min<unsigned>(jobs, (unsigned)images.size());
+  std::atomic<size_t> next{0};
+  std::atomic<unsigned> failed{0};
+  std::mutex log_mtx;
+  const auto t0 = std::chrono::steady_clock::now();
+
+  auto worker = [&]() {
+    FastForwardPipeline pipe(opt, post_lut);
+    FfFrameResult r;
+    for (size_t k = next++; k < images.size(); k = next++) {
+      const std::string& img = images[k];
+      int W = 32, H = 32;
+      std::vector<uint8_t> image;
+      if (!img.empty()) {
+        if (!load_bmp_grayscale(img, W, H, image)) {
+          std::lock_guard<std::mutex> g(log_mtx);
+          std::cerr << "Failed to load BMP '" << img << "'.\n";
+          ++failed;
+          continue;
+        }
+      } else {
+        image.resize(W*H);
+        for (int i = 0; i < W*H; ++i) image[i] = static_cast<uint8_t>(i % 256);
+      }
+
+      if (!pipe.run_frame(image, W, H, r)) {
+        std::lock_guard<std::mutex> g(log_mtx);
+        std::cerr << "[WARN] " << (img.empty() ? "ramp" : img) << ": read-back came up short\n";
+        ++failed;
+        continue;
+      }
+      write_pgm(out_path(img, "out.pgm"), W, H, r.out);
+      if (!hist_in_dump.empty())  (void)r.stats.dump_in (out_path(img, hist_in_dump));
+      if (!hist_out_dump.empty()) (void)r.stats.dump_out(out_path(img, hist_out_dump));
+
+      std::lock_guard<std::mutex> g(log_mtx);
+      std::cout << "[FF] " << (img.empty() ? "ramp" : img) << " " << W << "x" << H
+                << " dram_bytes=" << r.dram_bytes << " beats=" << r.beats << "\n";
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned j = 1; j < jobs; ++j) pool.emplace_back(worker);
+  worker();
+  for (auto& t : pool) t.join();
+
+  const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  std::cout << "[FF] frames=" << (images.size() - failed) << " failed=" << failed
+            << " jobs=" << jobs << " time=" << secs << " s";
+  if (secs > 0) std::cout << " rate=" << (images.size() - failed) / secs << " frames/s";
+  std::cout << "\n";
+  if (failed) return 1;
+  std::cout << "PASS\n";
+  return 0;
+}